@@ -65,6 +65,7 @@ main (int argc, const char *const argv[])
 (library (vicare platform features)\n\
   (export\n\
     HAVE_ACCEPT\n\
+    HAVE_ACCEPT4\n\
     HAVE_ACCESS\n\
     HAVE_ACOSH\n\
     HAVE_ALARM\n\
@@ -520,6 +521,13 @@ printf("(define-inline-constant HAVE_ACCEPT %s)\n",
   "#t"
 #else
   "#f"
+#endif
+  );
+  printf("(define-inline-constant HAVE_ACCEPT4 %s)\n",
+#ifdef HAVE_ACCEPT4
+  "#t"
+#else
+  "#f"
 #endif
   );
   printf("(define-inline-constant HAVE_ACCESS %s)\n",
@@ -264,6 +264,15 @@
 (define-constant off-string-length		(fx- disp-string-length string-tag))
 (define-constant off-string-data		(fx- disp-string-data   string-tag))
 
+;;The least significant bits of  the length fixnum select the representation
+;;of the data area: one 32-bit  character for every character; one octet for
+;;every character; a reference to a wide string, in the first data word of a
+;;narrow string in which a character above #\xFF has been stored.
+(define-constant string-repr-mask		#b11)
+(define-constant string-repr-wide		0)
+(define-constant string-repr-narrow		1)
+(define-constant string-repr-widened		2)
+
 
 ;;;; code objects
 
@@ -29,6 +29,31 @@
 		(condition))
 	      (make-irritants-condition (list port-identifier)))))
 
+;;False or  a procedure  to be applied  to a  file descriptor and  one of  the symbols
+;;"read" and "write"  when an operation on  a port wrapping the  non-blocking file
+;;descriptor would block.
+;;
+(define port-would-block-handler
+  (make-parameter #f
+    (lambda (obj)
+      (if (or (not obj)
+	      (procedure? obj))
+	  obj
+	(procedure-argument-violation 'port-would-block-handler
+	  "expected false or procedure as would-block handler" obj)))))
+
+(define (%wait-for-descriptor-readiness fd direction)
+  ;;To be called when an operation on  the non-blocking descriptor FD failed with
+  ;;EAGAIN; DIRECTION is the symbol "read"  or "write".  If a would-block handler is
+  ;;set: apply it to FD and DIRECTION and return true if the handler returns true,
+  ;;meaning  that FD  is now  ready and the  operation must be  retried.  Otherwise
+  ;;return false, meaning that EAGAIN must be reported as usual.
+  ;;
+  (let ((handler (port-would-block-handler)))
+    (and handler
+	 (handler fd direction)
+	 #t)))
+
 (case-define* %raise-io-error
   ;;Raise a  non-continuable exception describing  an input/output system  error from
   ;;the value of ERRNO.
@@ -139,28 +164,46 @@
   ;;standard close  function for  file descriptors  is used; else  the port  does not
   ;;support the close function.
   ;;
+  ;;If IO-URING-READ-AHEAD-DEPTH is set, the port can be closed and FD references a
+  ;;regular file, socket or pipe: data is read through an io_uring reader, when
+  ;;available.
+  ;;
+  (define reader
+    (and close-function
+	 (%open-uring-reader fd buffer.size)))
+
   (define set-position!
-    (%make-set-position!-function-for-file-descriptor-port fd port-identifier))
+    (if reader
+	(%make-set-position!-function-for-uring-reader reader port-identifier)
+      (%make-set-position!-function-for-file-descriptor-port fd port-identifier)))
 
   (define close
-    (cond ((procedure? close-function)
-	   close-function)
-	  ((and (boolean? close-function) close-function)
-	   (%make-close-function-for-platform-descriptor-port port-identifier fd))
-	  (else #f)))
-
-  (define (read! dst.bv dst.start requested-count)
-    (let ((count (capi::platform-read-fd fd dst.bv dst.start requested-count)))
-      (cond (($fx>= count 0)
-	     count)
-	    (($fx= count EAGAIN)
-	     (%raise-eagain-error 'read! #f port-identifier))
-	    (else
-	     (%raise-io-error 'read! port-identifier count (make-i/o-read-error))))))
+    (%wrap-close-function-for-uring-reader
+     reader
+     (cond ((procedure? close-function)
+	    close-function)
+	   ((and (boolean? close-function) close-function)
+	    (%make-close-function-for-platform-descriptor-port port-identifier fd))
+	   (else #f))))
+
+  (define read!
+    (if reader
+	(%make-read!-function-for-uring-reader reader port-identifier)
+      (lambda (dst.bv dst.start requested-count)
+	(let ((count (capi::platform-read-fd fd dst.bv dst.start requested-count)))
+	  (cond (($fx>= count 0)
+		 count)
+		(($fx= count EAGAIN)
+		 (if (%wait-for-descriptor-readiness fd 'read)
+		     (read! dst.bv dst.start requested-count)
+		   (%raise-eagain-error 'read! #f port-identifier)))
+		(else
+		 (%raise-io-error 'read! port-identifier count (make-i/o-read-error))))))))
 
   (let ((attributes		(%select-input-fast-tag-from-transcoder
 				 who maybe-transcoder
 				 other-attributes GUARDED-PORT-TAG PORT-WITH-FD-DEVICE
+				 (if reader PORT-WITH-READ-AHEAD-TAG 0)
 				 (%select-eol-style-from-transcoder who maybe-transcoder)
 				 DEFAULT-OTHER-ATTRS))
 	(buffer.index		0)
@@ -200,7 +243,9 @@
       (cond (($fx>= count 0)
 	     count)
 	    (($fx= count EAGAIN)
-	     (%raise-eagain-error 'write! #f port-identifier))
+	     (if (%wait-for-descriptor-readiness fd 'write)
+		 (write! src.bv src.start requested-count)
+	       (%raise-eagain-error 'write! #f port-identifier)))
 	    (else
 	     (%raise-io-error 'write! port-identifier count (make-i/o-write-error))))))
 
@@ -246,7 +291,9 @@
       (cond (($fx>= count 0)
 	     count)
 	    (($fx= count EAGAIN)
-	     (%raise-eagain-error 'read! #f port-identifier))
+	     (if (%wait-for-descriptor-readiness fd 'read)
+		 (read! dst.bv dst.start requested-count)
+	       (%raise-eagain-error 'read! #f port-identifier)))
 	    (else
 	     (%raise-io-error 'read! port-identifier count (make-i/o-read-error))))))
 
@@ -255,7 +302,9 @@
       (cond (($fx>= count 0)
 	     count)
 	    (($fx= count EAGAIN)
-	     (%raise-eagain-error 'write! #f port-identifier))
+	     (if (%wait-for-descriptor-readiness fd 'write)
+		 (write! src.bv src.start requested-count)
+	       (%raise-eagain-error 'write! #f port-identifier)))
 	    (else
 	     (%raise-io-error 'write! port-identifier count (make-i/o-write-error))))))
 
@@ -288,25 +337,40 @@
   ;;standard close  function for  file descriptors  is used; else  the port  does not
   ;;support the close operation.
   ;;
-  (define close
-    (cond ((procedure? close-function)
-	   close-function)
-	  ((and (boolean? close-function) close-function)
-	   (%make-close-function-for-platform-descriptor-port port-identifier sock))
-	  (else #f)))
+  ;;If IO-URING-READ-AHEAD-DEPTH is set and  the port can be closed: data is read
+  ;;through an io_uring reader, when available.
+  ;;
+  (define reader
+    (and close-function
+	 (%open-uring-reader sock buffer.size)))
 
-  (define (read! dst.bv dst.start requested-count)
-    (let ((count (capi::platform-read-fd sock dst.bv dst.start requested-count)))
-      (cond (($fx>= count 0)
-	     count)
-	    (($fx= count EAGAIN)
-	     (%raise-eagain-error 'read! #f port-identifier))
-	    (else
-	     (%raise-io-error 'read! port-identifier count (make-i/o-read-error))))))
+  (define close
+    (%wrap-close-function-for-uring-reader
+     reader
+     (cond ((procedure? close-function)
+	    close-function)
+	   ((and (boolean? close-function) close-function)
+	    (%make-close-function-for-platform-descriptor-port port-identifier sock))
+	   (else #f))))
+
+  (define read!
+    (if reader
+	(%make-read!-function-for-uring-reader reader port-identifier)
+      (lambda (dst.bv dst.start requested-count)
+	(let ((count (capi::platform-read-fd sock dst.bv dst.start requested-count)))
+	  (cond (($fx>= count 0)
+		 count)
+		(($fx= count EAGAIN)
+		 (if (%wait-for-descriptor-readiness sock 'read)
+		     (read! dst.bv dst.start requested-count)
+		   (%raise-eagain-error 'read! #f port-identifier)))
+		(else
+		 (%raise-io-error 'read! port-identifier count (make-i/o-read-error))))))))
 
   (let ((attributes		(%select-input-fast-tag-from-transcoder
 				 who transcoder other-attributes
 				 GUARDED-PORT-TAG PORT-WITH-FD-DEVICE
+				 (if reader PORT-WITH-READ-AHEAD-TAG 0)
 				 (%select-eol-style-from-transcoder who transcoder)
 				 DEFAULT-OTHER-ATTRS))
 	(buffer.index		0)
@@ -344,7 +408,9 @@
       (cond (($fx>= rv 0)
 	     rv)
 	    (($fx= rv EAGAIN)
-	     (%raise-eagain-error 'read! #f port-identifier))
+	     (if (%wait-for-descriptor-readiness sock 'write)
+		 (write! src.bv src.start requested-count)
+	       (%raise-eagain-error 'read! #f port-identifier)))
 	    (else
 	     (%raise-io-error 'write! port-identifier rv (make-i/o-write-error))))))
 
@@ -388,7 +454,9 @@
       (cond (($fx>= count 0)
 	     count)
 	    (($fx= count EAGAIN)
-	     (%raise-eagain-error 'read! #f port-identifier))
+	     (if (%wait-for-descriptor-readiness sock 'read)
+		 (read! dst.bv dst.start requested-count)
+	       (%raise-eagain-error 'read! #f port-identifier)))
 	    (else
 	     (%raise-io-error 'read! port-identifier count (make-i/o-read-error))))))
 
@@ -397,7 +465,9 @@
       (cond (($fx>= rv 0)
 	     rv)
 	    (($fx= rv EAGAIN)
-	     (%raise-eagain-error 'read! #f port-identifier))
+	     (if (%wait-for-descriptor-readiness sock 'write)
+		 (write! src.bv src.start requested-count)
+	       (%raise-eagain-error 'read! #f port-identifier)))
 	    (else
 	     (%raise-io-error 'write! port-identifier rv (make-i/o-write-error))))))
 
@@ -427,6 +497,82 @@
 	(%raise-io-error 'set-position! port-identifier errno
 			 (make-i/o-invalid-position-error position))))))
 
+;;; --------------------------------------------------------------------
+;;; io_uring read-ahead
+
+(module (%open-uring-reader)
+
+  (define (%open-uring-reader fd buffer.size)
+    ;;If the parameter IO-URING-READ-AHEAD-DEPTH is set: open and return a pointer
+    ;;object referencing an io_uring reader for the platform's descriptor FD.  Return
+    ;;false if the read-ahead is disabled, io_uring  is not available or FD does not
+    ;;reference a regular  file, socket or pipe; in this case  the port falls back to
+    ;;"read()".
+    ;;
+    ;;The reader is registered  in a guardian, so  that its  memory is released  even
+    ;;when the port is garbage collected without being closed.
+    ;;
+    (let ((depth (io-uring-read-ahead-depth)))
+      (and depth
+	   (let ((rv (capi::platform-uring-reader-open fd depth buffer.size)))
+	     (and (pointer? rv)
+		  (begin
+		    (uring-reader-guardian rv)
+		    rv))))))
+
+  (define uring-reader-guardian
+    (make-guardian))
+
+  (define (%close-garbage-collected-uring-readers)
+    ;;Releasing a reader twice is harmless: the first call resets the pointer to NULL.
+    ;;
+    (do ((reader (uring-reader-guardian) (uring-reader-guardian)))
+	((not reader))
+      (capi::platform-uring-reader-close reader)))
+
+  (post-gc-hooks (cons %close-garbage-collected-uring-readers (post-gc-hooks)))
+
+  #| end of module: %open-uring-reader |# )
+
+(define (%make-read!-function-for-uring-reader reader port-identifier)
+  ;;When the descriptor is in non-blocking mode  and no data is available: the read
+  ;;stays in flight  and the would-block handler waits for  the descriptor selected
+  ;;by the reader, which is the io_uring one while a read is in flight.
+  ;;
+  (define (read! dst.bv dst.start requested-count)
+    (let ((count (capi::platform-uring-reader-read reader dst.bv dst.start requested-count)))
+      (cond (($fx>= count 0)
+	     count)
+	    (($fx= count EAGAIN)
+	     (if (%wait-for-descriptor-readiness (capi::platform-uring-reader-wait-fd reader) 'read)
+		 (read! dst.bv dst.start requested-count)
+	       (%raise-eagain-error 'read! #f port-identifier)))
+	    (else
+	     (%raise-io-error 'read! port-identifier count (make-i/o-read-error))))))
+  read!)
+
+(define (%make-set-position!-function-for-uring-reader reader port-identifier)
+  ;;The read-ahead data is discarded and reading restarts from the new position.
+  ;;
+  (lambda (position)
+    (let ((errno (capi::platform-uring-reader-set-position reader position)))
+      (when errno
+	(%raise-io-error 'set-position! port-identifier errno
+			 (make-i/o-invalid-position-error position))))))
+
+(define (%wrap-close-function-for-uring-reader reader close)
+  ;;If READER is  a pointer: return a  close function that releases  it before
+  ;;applying CLOSE; otherwise return CLOSE itself.
+  ;;
+  (if reader
+      (lambda ()
+	(capi::platform-uring-reader-close reader)
+	(when close
+	  (close)))
+    close))
+
+;;; --------------------------------------------------------------------
+
 (define (%make-close-function-for-platform-descriptor-port port-identifier fd)
   ;;Return a  standard CLOSE function for  a port wrapping the  platform's descriptor
   ;;FD.  It is used for both file  descriptors and socket descriptors, and in general
@@ -492,6 +638,166 @@
      (%file-descriptor->input-port fd other-attributes port-identifier buffer-size
 				   maybe-transcoder close-function __who__))))
 
+(case-define* open-file-input-port/mmap
+  ;;Like OPEN-FILE-INPUT-PORT,  but map  the file in  memory and  serve the  input
+  ;;operations by copying  octets directly from the mapping,  without "read()" system
+  ;;calls.  Setting the port position is a constant time operation.
+  ;;
+  ;;If the file cannot be mapped (for example  it is a FIFO or a character device):
+  ;;fall back to a port wrapping the file descriptor, as OPEN-FILE-INPUT-PORT does.
+  ;;
+  ;;The file is mapped at the size it has when the port is opened; octets appended
+  ;;after that are not visible through the port.
+  ;;
+  ((filename)
+   (open-file-input-port/mmap filename (file-options) 'block #f))
+
+  ((filename file-options)
+   (open-file-input-port/mmap filename file-options   'block #f))
+
+  ((filename file-options buffer-mode)
+   (open-file-input-port/mmap filename file-options   buffer-mode #f))
+
+  (({filename filename?} {file-options file-options?} buffer-mode {maybe-transcoder false-or-transcoder?})
+   (let* ((other-attributes	(%buffer-mode->attributes buffer-mode __who__))
+	  (fd			(%open-input-file-descriptor filename file-options __who__))
+	  (port-identifier	filename)
+	  (buffer-size		(input-file-buffer-size))
+	  (rv			(capi::platform-mmap-input-fd fd)))
+     (if (pair? rv)
+	 (begin
+	   ;;The mapping stays valid after the descriptor is closed.
+	   (let ((errno (capi::platform-close-fd fd)))
+	     (when errno
+	       (capi::platform-mmap-input-close (car rv) (cdr rv))
+	       (%raise-io-error __who__ port-identifier errno)))
+	   (%mapping->input-port (car rv) (cdr rv) other-attributes port-identifier buffer-size
+				 maybe-transcoder __who__))
+       (%file-descriptor->input-port fd other-attributes port-identifier buffer-size
+				     maybe-transcoder #t __who__)))))
+
+(define (%mapping->input-port mapping size other-attributes port-identifier buffer.size
+			      maybe-transcoder who)
+  ;;Given the pointer  object MAPPING referencing a read-only  mapping of SIZE octets:
+  ;;build and return a Scheme input port to be used to read the data.
+  ;;
+  ;;The device of the returned port is an MMAP-MAPPING struct and the port is tagged
+  ;;with PORT-WITH-MMAP-DEVICE-TAG; the  bulk input functions recognise it and  copy
+  ;;octets straight into the destination, skipping the port's buffer.
+  ;;
+  (define device
+    (make-mmap-mapping mapping size 1))
+
+  (define position 0)
+  ;;Offset in the mapping of the next octet to be copied by READ!.  It is always equal
+  ;;to the position in the cookie.
+
+  (define (read! dst.bv dst.start requested-count)
+    (let* ((available	(- size position))
+	   (count	(cond ((<= available 0)			0)
+			      ((< available requested-count)	available)
+			      (else				requested-count))))
+      (unless ($fxzero? count)
+	(capi::platform-mmap-input-read mapping position dst.bv dst.start count)
+	(set! position (+ position count)))
+      count))
+
+  (define (set-position! new-position)
+    (set! position new-position))
+
+  (define (close)
+    (%mmap-mapping-release! device))
+
+  (let ((attributes		(%select-input-fast-tag-from-transcoder
+				 who maybe-transcoder
+				 other-attributes GUARDED-PORT-TAG PORT-WITH-MMAP-DEVICE-TAG
+				 (%select-eol-style-from-transcoder who maybe-transcoder)
+				 DEFAULT-OTHER-ATTRS))
+	(buffer.index		0)
+	(buffer.used-size	0)
+	(buffer			(make-bytevector buffer.size))
+	(write!			#f)
+	(get-position		#t)
+	(cookie			(default-cookie device)))
+    (%port->maybe-guarded-port
+     ($make-port attributes buffer.index buffer.used-size buffer
+		 maybe-transcoder port-identifier
+		 read! write! get-position set-position! close cookie))))
+
+;;; --------------------------------------------------------------------
+;;; memory-mapped files
+
+(define-struct mmap-mapping
+  ;;The device of the ports returned by OPEN-FILE-INPUT-PORT/MMAP.
+  ;;
+  (pointer
+		;Pointer object referencing the mapping; NULL if the file is empty.
+   size
+		;Non-negative exact integer, the number of octets in the mapping.
+   refcount
+		;Non-negative fixnum,  the number of users  of the mapping: the port,
+		;while open, plus the live memory-blocks returned by MMAP-PORT-REGION.
+		;The file is unmapped when it becomes zero.
+   ))
+
+(define (%mmap-mapping-acquire! M)
+  (set-mmap-mapping-refcount! M (fxadd1 (mmap-mapping-refcount M))))
+
+(define (%mmap-mapping-release! M)
+  (let ((refcount (fxsub1 (mmap-mapping-refcount M))))
+    (set-mmap-mapping-refcount! M refcount)
+    (when (fxzero? refcount)
+      (capi::platform-mmap-input-close (mmap-mapping-pointer M) (mmap-mapping-size M)))))
+
+(define (mmap-port? obj)
+  ;;Return true if OBJ is an input port reading from a memory-mapped file.
+  ;;
+  (and (port? obj)
+       (%mmap-port? obj)))
+
+(module (mmap-port-region)
+
+  (define* (mmap-port-region {port mmap-port?} {start non-negative-exact-integer?} {count non-negative-exact-integer?})
+    ;;Return a non-owner memory-block referencing COUNT octets of the file mapped by
+    ;;PORT, starting at offset START from the beginning of the file.  No data is
+    ;;copied.
+    ;;
+    ;;The mapping is kept alive as long as the memory-block is referenced, even after
+    ;;PORT is closed or garbage collected:  every region holds a reference count on
+    ;;the mapping, which is released by a post-GC hook when the memory-block is
+    ;;collected.
+    ;;
+    (when ($port-closed? port)
+      (assertion-violation __who__ "expected open port as argument" port))
+    (let ((M (cookie-dest ($port-cookie port))))
+      (unless (<= (+ start count) (mmap-mapping-size M))
+	(procedure-arguments-consistency-violation __who__
+	  "region exceeds the size of the mapped file" start count))
+      (let ((region (make-memory-block (pointer-add (mmap-mapping-pointer M) start) count)))
+	(%mmap-mapping-acquire! M)
+	(set! live-regions (cons (weak-cons region M) live-regions))
+	region)))
+
+  (define live-regions
+    ;;List of weak pairs: the car is a memory-block returned by MMAP-PORT-REGION, the
+    ;;cdr is the MMAP-MAPPING it references.
+    ;;
+    '())
+
+  (define (%release-collected-regions)
+    (set! live-regions (let loop ((ell live-regions))
+			 (cond ((null? ell)
+				'())
+			       ((bwp-object? (caar ell))
+				(%mmap-mapping-release! (cdar ell))
+				(loop (cdr ell)))
+			       (else
+				(cons (car ell) (loop (cdr ell))))))))
+
+  (post-gc-hooks (cons %release-collected-regions (post-gc-hooks)))
+
+  #| end of module: mmap-port-region |# )
+
 (module (open-input-file
 	 with-input-from-file
 	 call-with-input-file)
@@ -67,7 +67,9 @@
 ;;   true if port has an extract function      |
 ;;                         EOL style bits   |||
 ;;     true if the device is a file desc.  |
-;;                            unused bits |
+;;     true if reading ahead from device  |
+;;
+;;Bit 24, left of the diagram, is true if the device is a memory-mapped file.
 ;;                                        321098765432109876543210
 (define INPUT/OUTPUT-PORT-TAG		#b000000000100000000000000)
 		;Used to tag ports that are both input and output.
@@ -86,10 +88,19 @@
 		;TRANSCODED-PORT.
 (define PORT-WITH-FD-DEVICE		#b010000000000000000000000)
 		;Used to tag ports that have a file descriptor as device.
+(define PORT-WITH-READ-AHEAD-TAG	#b100000000000000000000000)
+		;Used to tag  input ports whose READ!  function  reads ahead from the
+		;file descriptor device, so the  device position does not match the
+		;port's one and the descriptor must not be read directly.  See the
+		;io_uring read-ahead for file descriptor ports.
+(define PORT-WITH-MMAP-DEVICE-TAG	#b1000000000000000000000000)
+		;Used to tag  binary input ports whose device  is a memory-mapped
+		;file, so that the bulk input functions can copy octets straight
+		;from the mapping.  See OPEN-FILE-INPUT-PORT/MMAP.
 
 ;;                                                321098765432109876543210
 (define EOL-STYLE-MASK				#b001110000000000000000000)
-(define EOL-STYLE-NOT-MASK			#b110001111111111111111111)
+(define EOL-STYLE-NOT-MASK			#b1110001111111111111111111)
 (define EOL-LINEFEED-TAG			#b000010000000000000000000) ;;symbol -> lf
 (define EOL-CARRIAGE-RETURN-TAG			#b000100000000000000000000) ;;symbol -> cr
 (define EOL-CARRIAGE-RETURN-LINEFEED-TAG	#b000110000000000000000000) ;;symbol -> crlf
@@ -307,7 +318,7 @@
 ;;attributes.
 ;;
 ;;					  321098765432109876543210
-(define BUFFER-MODE-NOT-MASK		#b111111100111111111111111)
+(define BUFFER-MODE-NOT-MASK		#b1111111100111111111111111)
 
 (define-inline ($set-port-buffer-mode-to-block! ?port)
   ($set-port-attrs! ?port ($fxand BUFFER-MODE-NOT-MASK ($port-attrs ?port))))
@@ -324,7 +335,7 @@
 
 ;;                                 321098765432109876543210
 (define FAST-ATTRS-MASK          #b000000000011111111111111)
-(define OTHER-ATTRS-MASK         #b111111111100000000000000)
+(define OTHER-ATTRS-MASK         #b1111111111100000000000000)
 
 (define-inline ($port-fast-attrs port)
   ;;Extract the fast attributes from the tag of PORT.
@@ -341,6 +352,13 @@
   ;;
   ($set-port-attrs! port ($fxior ($port-other-attrs port) fast-attrs)))
 
+(define-inline (%mmap-port? port)
+  ;;PORT must be a port.  Return true if  its device is a memory-mapped file; the tag
+  ;;is set when the port is opened, so the bulk input functions can dispatch on it
+  ;;cheaply.
+  ;;
+  ($fx= PORT-WITH-MMAP-DEVICE-TAG ($fxand ($port-attrs port) PORT-WITH-MMAP-DEVICE-TAG)))
+
 (define-inline ($port-fast-attrs-or-zero obj)
   ;;Given  a Scheme  value:  if it  is  a port  value  extract the  fast
   ;;attributes and return  them, else return zero.  Notice  that zero is
@@ -195,6 +195,7 @@
   (define-predicate $guarded-port?		GUARDED-PORT-TAG)
   (define-predicate $port-with-extraction?	PORT-WITH-EXTRACTION-TAG)
   (define-predicate $port-with-fd-device?	PORT-WITH-FD-DEVICE)
+  (define-predicate $port-with-read-ahead?	PORT-WITH-READ-AHEAD-TAG)
   #| end of LET-SYNTAX |# )
 
 (define-syntax-rule ($last-port-operation-was-input? port)
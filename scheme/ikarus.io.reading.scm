@@ -196,7 +196,8 @@
 		(raise E)))
        (let* ((buffer  port.buffer)
 	      (max     ($fx- port.buffer.size port.buffer.used-size))
-	      (count   (port.read! buffer port.buffer.used-size max)))
+	      (count   (%with-device-call-accounting (port read)
+			 (port.read! buffer port.buffer.used-size max))))
 	 (cond ((not (fixnum? count))
 		(assertion-violation who "invalid return value from read! procedure" count))
 	       ((and ($fx> 0   count)
@@ -205,10 +206,44 @@
 	       (else
 		(port.device.position.incr!  count)
 		(port.buffer.used-size.incr! count)
+		(let ((stats (%port-stats port)))
+		  (when stats
+		    (%port-stats-after-refill! port stats count max)))
 		count))))))
 
   #| end of module: %REFILL-INPUT-PORT-BYTEVECTOR-BUFFER |# )
 
+(define (%mmap-consume-bytes! port dst.bv dst.start requested-count)
+  ;;PORT must be a binary input port  reading from a memory-mapped file.  Copy up to
+  ;;REQUESTED-COUNT octets  into DST.BV, starting  at DST.START: first  the buffered
+  ;;ones, then the rest straight from the mapping.  Return EOF or the number of copied
+  ;;octets.
+  ;;
+  (with-port-having-bytevector-buffer (port)
+    (let* ((buffered	($fx- port.buffer.used-size port.buffer.index))
+	   (from-buffer	(if ($fx< requested-count buffered) requested-count buffered))
+	   (rest	($fx- requested-count from-buffer)))
+      ($bytevector-copy!/count port.buffer port.buffer.index dst.bv dst.start from-buffer)
+      (port.buffer.index.incr! from-buffer)
+      (let* ((from-device	(if ($fxzero? rest)
+				    0
+				  (%with-device-call-accounting (port read)
+				    (port.read! dst.bv ($fx+ dst.start from-buffer) rest))))
+	     (total		($fx+ from-buffer from-device)))
+	(port.device.position.incr! from-device)
+	(if ($fxzero? total)
+	    (eof-object)
+	  total)))))
+
+(define (%mmap-available-bytes port)
+  ;;PORT must be a binary input port  reading from a memory-mapped file.  Return the
+  ;;number of octets that can still be read: buffered ones plus unread ones in the
+  ;;mapping.
+  ;;
+  (with-port-having-bytevector-buffer (port)
+    (+ ($fx- port.buffer.used-size port.buffer.index)
+       (max 0 (- (mmap-mapping-size port.device) port.device.position)))))
+
 
 ;;;; string buffer handling for input ports
 ;;
@@ -378,7 +413,8 @@
 		 (raise E)))
 	(let* ((buffer  port.buffer)
 	       (max     ($fx- port.buffer.size port.buffer.used-size))
-	       (count   (port.read! buffer port.buffer.used-size max)))
+	       (count   (%with-device-call-accounting (port read)
+			  (port.read! buffer port.buffer.used-size max))))
 	  (cond ((not (fixnum? count))
 		 (assertion-violation who "invalid return value from read! procedure" count))
 		((and ($fx> 0   count)
@@ -387,6 +423,9 @@
 		(else
 		 (port.device.position.incr!  count)
 		 (port.buffer.used-size.incr! count)
+		 (let ((stats (%port-stats port)))
+		   (when stats
+		     (%port-stats-after-refill! port stats count max)))
 		 count))))))
 
   #| end of module: %REFILL-INPUT-PORT-STRING-BUFFER |# )
@@ -555,9 +594,17 @@
   (define* (get-bytevector-n port {count fixnum-count?})
     (%case-binary-input-port-fast-tag (port __who__)
       ((FAST-GET-BYTE-TAG)
-       (if (zero? count)
-	   (quote #vu8())
-	 (%consume-bytes port count)))))
+       (cond ((zero? count)
+	      (quote #vu8()))
+	     ((%mmap-port? port)
+	      (let ((count (min count (%mmap-available-bytes port))))
+		(if ($fxzero? count)
+		    (eof-object)
+		  (let ((dst.bv ($make-bytevector count)))
+		    (%mmap-consume-bytes! port dst.bv 0 count)
+		    dst.bv))))
+	     (else
+	      (%consume-bytes port count))))))
 
   (define (%consume-bytes port requested-count)
     ;;To be  called when the  request must be satisfied  by consuming bytes  from the
@@ -687,9 +734,12 @@
     (assert-count-from-start-index-for-bytevector dst.bv dst.start count)
     (%case-binary-input-port-fast-tag (port __who__)
       ((FAST-GET-BYTE-TAG)
-       (if ($fxzero? count)
-	   count
-	 (%consume-bytes port dst.bv dst.start count)))))
+       (cond (($fxzero? count)
+	      count)
+	     ((%mmap-port? port)
+	      (%mmap-consume-bytes! port dst.bv dst.start count))
+	     (else
+	      (%consume-bytes port dst.bv dst.start count))))))
 
   (define (%consume-bytes port dst.bv dst.start requested-count)
     (with-port-having-bytevector-buffer (port)
@@ -742,6 +792,118 @@
 
   #| end of module: GET-BYTEVECTOR-N! |# )
 
+
+;;;; bytevector input functions: GET-BYTEVECTORS-N!
+
+(module (get-bytevectors-n!)
+  ;;Vicare extension.  Read octets from the binary input PORT, blocking as necessary,
+  ;;filling  in order the  bytevector slices selected by  the list SLICES; each item
+  ;;must be a bytevector or a list "(BV START COUNT)" selecting a portion of
+  ;;bytevector.  Return the EOF object, the would-block object or the total number of
+  ;;octets read, with the same semantics of GET-BYTEVECTOR-N!.
+  ;;
+  ;;When PORT has a file  descriptor as device: the octets already in the buffer are
+  ;;consumed first, then the slices and the  port's buffer itself are handed to a
+  ;;single "readv()" call;  the slices are filled directly and  whatever follows them
+  ;;is left in the buffer.  Ports reading  ahead from the device use GET-BYTEVECTOR-N!
+  ;;on each slice.
+  ;;
+  (define-module-who get-bytevectors-n!)
+
+  (define* (get-bytevectors-n! port {slices list?})
+    (receive (vec total)
+	(%bytevector-slices->vector __who__ slices (length slices))
+      (%case-binary-input-port-fast-tag (port __who__)
+	((FAST-GET-BYTE-TAG)
+	 (cond (($fxzero? total)
+		0)
+	       ((and ($port-with-fd-device? port)
+		     (not ($port-with-read-ahead? port)))
+		(%scatter-read port vec total))
+	       (else
+		(%read-each-slice port vec)))))))
+
+  (define (%scatter-read port vec total)
+    (with-port-having-bytevector-buffer (port)
+      (define-constant last-triplet
+	($fx- ($vector-length vec) 3))
+      (define (%done done)
+	(if ($fxzero? done)
+	    (eof-object)
+	  done))
+      (let next-read ((first 0) (skip 0) (done 0))
+	;;Consume the octets already in the buffer.
+	(let* ((avail ($fx- port.buffer.used-size port.buffer.index))
+	       (count (if ($fx< avail ($fx- total done))
+			  avail
+			($fx- total done))))
+	  (let copy ((first first) (skip skip) (count count) (done done))
+	    (receive (first skip)
+		(%bytevector-slices-advance vec first skip 0)
+	      (cond ((not ($fxzero? count))
+		     (let* ((i		($fx* 3 first))
+			    (room	($fx- ($vector-ref vec ($fx+ 2 i)) skip))
+			    (n		(if ($fx< count room) count room)))
+		       ($bytevector-copy!/count port.buffer port.buffer.index
+						($vector-ref vec i) ($fx+ skip ($vector-ref vec ($fxadd1 i)))
+						n)
+		       (port.buffer.index.incr! n)
+		       (copy first ($fx+ skip n) ($fx- count n) ($fx+ done n))))
+		    (($fx= done total)
+		     done)
+		    (else
+		     ;;The buffer is empty:  read into the remaining slices and into the
+		     ;;buffer itself.
+		     (port.buffer.reset-to-empty!)
+		     ($vector-set! vec last-triplet          port.buffer)
+		     ($vector-set! vec ($fx+ 2 last-triplet) port.buffer.size)
+		     (let ((count (%with-device-call-accounting (port read)
+				    (capi::platform-readv-fd port.device vec first skip))))
+		       (cond (($fxzero? count)
+			      (%done done))
+			     (($fx> count 0)
+			      (port.device.position.incr! count)
+			      (let ((wanted ($fx- total done)))
+				(if ($fx< wanted count)
+				    (begin
+				      ;;The octets past the slices are in the buffer.
+				      (set! port.buffer.used-size ($fx- count wanted))
+				      total)
+				  (receive (first skip)
+				      (%bytevector-slices-advance vec first skip count)
+				    (next-read first skip ($fx+ done count))))))
+			     (($fx= count EAGAIN)
+			      (cond ((not ($fxzero? done))
+				     done)
+				    ((or (strict-r6rs)
+					 (%wait-for-descriptor-readiness port.device 'read))
+				     (next-read first skip done))
+				    (else
+				     WOULD-BLOCK-OBJECT)))
+			     (else
+			      (%raise-io-error __module_who__ port.id count (make-i/o-read-error))))))))))))
+
+  (define (%read-each-slice port vec)
+    (let loop ((idx 0) (done 0))
+      (if ($fx< idx ($fx- ($vector-length vec) 3))
+	  (let* ((bv		($vector-ref vec idx))
+		 (start		($vector-ref vec ($fxadd1 idx)))
+		 (count		($vector-ref vec ($fx+ 2 idx)))
+		 (rv		(if ($fxzero? count)
+				    0
+				  (get-bytevector-n! port bv start count))))
+	    (cond ((eof-object? rv)
+		   (if ($fxzero? done) rv done))
+		  ((would-block-object? rv)
+		   (if ($fxzero? done) rv done))
+		  (($fx< rv count)
+		   ($fx+ done rv))
+		  (else
+		   (loop ($fx+ 3 idx) ($fx+ done rv)))))
+	done)))
+
+  #| end of module: GET-BYTEVECTORS-N! |# )
+
 
 ;;;; bytevector input functions: GET-BYTEVECTOR-SOME
 
@@ -864,6 +1026,149 @@
 
   #| end of module: GET-BYTEVECTOR-ALL |# )
 
+
+;;;; fixed-width numeric input
+
+(module (get-u16-native	get-u16-le	get-u16-be
+	 get-s16-native	get-s16-le	get-s16-be
+	 get-u32-native	get-u32-le	get-u32-be
+	 get-s32-native	get-s32-le	get-s32-be
+	 get-u64-native	get-u64-le	get-u64-be
+	 get-s64-native	get-s64-le	get-s64-be
+	 get-f32-native	get-f32-le	get-f32-be
+	 get-f64-native	get-f64-le	get-f64-be
+	 get-u32-vector!	get-s32-vector!	get-f64-vector!)
+  ;;Defined by Vicare.  Decode  fixed-width numeric fields straight from the buffer of
+  ;;a binary  input port, without building  intermediate bytevectors.  The  getters of
+  ;;single fields return the EOF object, the would-block object or a number:
+  ;;
+  ;;* If enough octets are available: decode  them and update PORT to point just past
+  ;;them.
+  ;;
+  ;;* If the end of file is reached  before enough octets are available: return the
+  ;;EOF object.  The trailing octets are  left in the buffer, so they can be consumed
+  ;;with GET-BYTEVECTOR-ALL.
+  ;;
+  ;;* If the underlying device is in  non-blocking mode and not enough octets are
+  ;;available: return the would-block object.  The octets already buffered are kept.
+  ;;
+  ;;The bulk getters store up to COUNT  fields in a vector and return the number of
+  ;;fields actually read, the EOF object or the would-block object.
+  ;;
+  (define-syntax define-fixed-width-getter
+    (syntax-rules ()
+      ((_ ?who ?size ?unsafe-ref)
+       (define* (?who port)
+	 (%case-binary-input-port-fast-tag (port __who__)
+	   ((FAST-GET-BYTE-TAG)
+	    (with-port-having-bytevector-buffer (port)
+	      (let ((buffer.offset port.buffer.index))
+		(if ($fx<= ($fx+ buffer.offset ?size) port.buffer.used-size)
+		    ;;This is the fast path: the whole field is in the buffer.
+		    (begin
+		      (set! port.buffer.index ($fx+ buffer.offset ?size))
+		      (?unsafe-ref port.buffer buffer.offset))
+		  (let ((rv (%make-octets-available port ?size __who__)))
+		    (if (eq? rv #t)
+			(let ((buffer.offset port.buffer.index))
+			  (set! port.buffer.index ($fx+ buffer.offset ?size))
+			  (?unsafe-ref port.buffer buffer.offset))
+		      rv)))))))))
+      ))
+
+  (define-syntax define-fixed-width-vector-getter
+    (syntax-rules ()
+      ((_ ?who ?size ?unsafe-ref)
+       (define* (?who port {dst.vec vector?} {dst.start fixnum-start-index?} {count fixnum-count?} endianness)
+	 (assert-endianness endianness)
+	 (assert-start-index-for-vector dst.vec dst.start)
+	 (assert-count-from-start-index-for-vector dst.vec dst.start count)
+	 (%case-binary-input-port-fast-tag (port __who__)
+	   ((FAST-GET-BYTE-TAG)
+	    (with-port-having-bytevector-buffer (port)
+	      (let ((dst.past ($fx+ dst.start count)))
+		(let next-chunk ((dst.index dst.start))
+		  (if ($fx= dst.index dst.past)
+		      count
+		    (let ((chunk ($fxmin ($fx- dst.past dst.index)
+					 ($fxquotient ($fx- port.buffer.used-size port.buffer.index)
+						      ?size))))
+		      (if ($fxpositive? chunk)
+			  ;;Decode all the whole fields that are already buffered.
+			  (let ((chunk.past ($fx+ dst.index chunk)))
+			    (let next-field ((dst.index     dst.index)
+					     (buffer.offset port.buffer.index))
+			      (if ($fx< dst.index chunk.past)
+				  (begin
+				    ($vector-set! dst.vec dst.index
+						  (?unsafe-ref port.buffer buffer.offset endianness))
+				    (next-field ($fxadd1 dst.index) ($fx+ buffer.offset ?size)))
+				(begin
+				  (set! port.buffer.index buffer.offset)
+				  (next-chunk dst.index)))))
+			(let ((rv (%make-octets-available port ?size __who__)))
+			  (cond ((eq? rv #t)
+				 (next-chunk dst.index))
+				(($fx= dst.index dst.start)
+				 rv)
+				(else
+				 ($fx- dst.index dst.start))))))))))))))
+      ))
+
+  (define (%make-octets-available port size who)
+    ;;Refill the buffer of  PORT until at least SIZE octets are  available to be read.
+    ;;Return true, the EOF object or the  would-block object.  SIZE must not exceed the
+    ;;minimum buffer size, which is 8.
+    ;;
+    (with-port-having-bytevector-buffer (port)
+      (let retry-after-refill ()
+	(if ($fx<= ($fx+ port.buffer.index size) port.buffer.used-size)
+	    #t
+	  (refill-bytevector-buffer-and-evaluate (port who)
+	    (if-end-of-file:
+	     (eof-object))
+	    (if-refilling-would-block:
+	     (if (strict-r6rs)
+		 (retry-after-refill)
+	       WOULD-BLOCK-OBJECT))
+	    (if-successful-refill:
+	     (retry-after-refill)))))))
+
+  (define-fixed-width-getter get-u16-native	2 $bytevector-u16n-ref)
+  (define-fixed-width-getter get-u16-le		2 $bytevector-u16l-ref)
+  (define-fixed-width-getter get-u16-be		2 $bytevector-u16b-ref)
+  (define-fixed-width-getter get-s16-native	2 $bytevector-s16n-ref)
+  (define-fixed-width-getter get-s16-le		2 $bytevector-s16l-ref)
+  (define-fixed-width-getter get-s16-be		2 $bytevector-s16b-ref)
+
+  (define-fixed-width-getter get-u32-native	4 $bytevector-u32n-ref)
+  (define-fixed-width-getter get-u32-le		4 $bytevector-u32l-ref)
+  (define-fixed-width-getter get-u32-be		4 $bytevector-u32b-ref)
+  (define-fixed-width-getter get-s32-native	4 $bytevector-s32n-ref)
+  (define-fixed-width-getter get-s32-le		4 $bytevector-s32l-ref)
+  (define-fixed-width-getter get-s32-be		4 $bytevector-s32b-ref)
+
+  (define-fixed-width-getter get-u64-native	8 $bytevector-u64n-ref)
+  (define-fixed-width-getter get-u64-le		8 $bytevector-u64l-ref)
+  (define-fixed-width-getter get-u64-be		8 $bytevector-u64b-ref)
+  (define-fixed-width-getter get-s64-native	8 $bytevector-s64n-ref)
+  (define-fixed-width-getter get-s64-le		8 $bytevector-s64l-ref)
+  (define-fixed-width-getter get-s64-be		8 $bytevector-s64b-ref)
+
+  (define-fixed-width-getter get-f32-native	4 $bytevector-ieee-single-native-ref)
+  (define-fixed-width-getter get-f32-le		4 $bytevector-ieee-single-little-ref)
+  (define-fixed-width-getter get-f32-be		4 $bytevector-ieee-single-big-ref)
+
+  (define-fixed-width-getter get-f64-native	8 $bytevector-ieee-double-native-ref)
+  (define-fixed-width-getter get-f64-le		8 $bytevector-ieee-double-little-ref)
+  (define-fixed-width-getter get-f64-be		8 $bytevector-ieee-double-big-ref)
+
+  (define-fixed-width-vector-getter get-u32-vector!	4 $bytevector-u32-ref)
+  (define-fixed-width-vector-getter get-s32-vector!	4 $bytevector-s32-ref)
+  (define-fixed-width-vector-getter get-f64-vector!	8 $bytevector-ieee-double-ref)
+
+  #| end of module: fixed-width numeric input |# )
+
 
 ;;;; single-character input
 
@@ -1078,6 +1383,9 @@
 
     ;;
 
+    (define-syntax-rule (%no-bulk-decoding port dst.str dst.index dst.past)
+      dst.index)
+
     (define-syntax-rule (%read-char port who)
       (%read-char-from-port-with-fast-get-char-tag port who))
 
@@ -1429,34 +1737,39 @@
 		    1
 		    %read-char-from-port-with-fast-get-utf8-tag
 		    %peek-char-from-port-with-fast-get-utf8-tag
-		    %peek-char-from-port-with-utf8-codec))
+		    %peek-char-from-port-with-utf8-codec
+		    %decode-ascii-run-from-port-with-fast-get-utf8-tag))
 	  ((FAST-GET-CHAR-TAG)
 	   (%get-it dst.past
 		    1
 		    %read-char-from-port-with-fast-get-char-tag
 		    %peek-char
-		    %peek-char/offset))
+		    %peek-char/offset
+		    %no-bulk-decoding))
 	  ((FAST-GET-LATIN-TAG)
 	   (%get-it dst.past
 		    1
 		    %read-char-from-port-with-fast-get-latin1-tag
 		    %peek-latin1
-		    %peek-latin1/offset))
+		    %peek-latin1/offset
+		    %no-bulk-decoding))
 	  ((FAST-GET-UTF16LE-TAG)
 	   (%get-it dst.past
 		    2
 		    %read-utf16le
 		    %peek-utf16le
-		    %peek-utf16le/offset))
+		    %peek-utf16le/offset
+		    %no-bulk-decoding))
 	  ((FAST-GET-UTF16BE-TAG)
 	   (%get-it dst.past
 		    2
 		    %read-utf16be
 		    %peek-utf16be
-		    %peek-utf16be/offset)))))
+		    %peek-utf16be/offset
+		    %no-bulk-decoding)))))
 
     (define-syntax-rule (%get-it ?dst.past ?offset-of-ch2 ?read-char-proc
-				 ?peek-char-proc ?peek-char/offset-proc)
+				 ?peek-char-proc ?peek-char/offset-proc ?bulk-decode-proc)
       ;;Actually perform  the reading.  Loop reading  the next char and  updating the
       ;;port position;  read chars  are stored  into DST.STR.   If no  characters are
       ;;available return the EOF object or the would-block object.  Remember that, as
@@ -1486,10 +1799,22 @@
       ;;2-chars line-ending sequences always have a carriage return as first char and
       ;;we know, once the codec has been selected, the offset of such character.
       ;;
-      (let read-next-char ((dst.index dst.start))
+      ;;?BULK-DECODE-PROC must be the identifier of a function or macro decoding, in a
+      ;;single step,  a run of  characters already in the  buffer that need  no EOL
+      ;;conversion; it returns the index in DST.STR past the decoded characters.
+      ;;
+      (let ((dst.index (?bulk-decode-proc port dst.str dst.start ?dst.past)))
+	(if ($fx= dst.index ?dst.past)
+	    ($fx- dst.index dst.start)
+	  (%read-next-char dst.index ?dst.past ?offset-of-ch2 ?read-char-proc
+			   ?peek-char-proc ?peek-char/offset-proc ?bulk-decode-proc))))
+
+    (define-syntax-rule (%read-next-char ?dst.index ?dst.past ?offset-of-ch2 ?read-char-proc
+					 ?peek-char-proc ?peek-char/offset-proc ?bulk-decode-proc)
+      (let read-next-char ((dst.index ?dst.index))
 	(define (%store-char-then-loop-or-return ch)
 	  ($string-set! dst.str dst.index ch)
-	  (let ((dst.index ($fxadd1 dst.index)))
+	  (let ((dst.index (?bulk-decode-proc port dst.str ($fxadd1 dst.index) ?dst.past)))
 	    (if ($fx= dst.index ?dst.past)
 		($fx- dst.index dst.start)
 	      (read-next-char dst.index))))
@@ -1683,36 +2008,51 @@
       (%case-textual-input-port-fast-tag (port who)
 	((FAST-GET-UTF8-TAG)
 	 (%get-it %read-char-from-port-with-fast-get-utf8-tag
-		  %peek-char-from-port-with-fast-get-utf8-tag))
+		  %peek-char-from-port-with-fast-get-utf8-tag
+		  %read-ascii-line-run-from-port-with-fast-get-utf8-tag))
 	((FAST-GET-CHAR-TAG)
 	 (%get-it %read-char-from-port-with-fast-get-char-tag
-		  %peek-char-from-port-with-fast-get-char-tag))
+		  %peek-char-from-port-with-fast-get-char-tag
+		  %no-bulk-decoding))
 	((FAST-GET-LATIN-TAG)
 	 (%get-it %read-char-from-port-with-fast-get-latin1-tag
-		  %peek-char-from-port-with-fast-get-latin1-tag))
+		  %peek-char-from-port-with-fast-get-latin1-tag
+		  %no-bulk-decoding))
 	((FAST-GET-UTF16LE-TAG)
-	 (%get-it %read-utf16le %peek-utf16le))
+	 (%get-it %read-utf16le %peek-utf16le %no-bulk-decoding))
 	((FAST-GET-UTF16BE-TAG)
-	 (%get-it %read-utf16be %peek-utf16be))))
+	 (%get-it %read-utf16be %peek-utf16be %no-bulk-decoding))))
 
-    (define-syntax-rule (%get-it ?read-char ?peek-char)
+    (define-syntax-rule (%get-it ?read-char ?peek-char ?read-run)
+      ;;?READ-RUN  must  be the  identifier  of  a function  or  macro returning  a
+      ;;string holding a run of characters that  are not line endings, or false if
+      ;;no such run is  available in the buffer.  The list REVERSE-CHARS  holds both
+      ;;characters and such strings.
+      ;;
       (let ((eol-bits (%port-eol-style-bits port)))
 	(let loop ((port			port)
 		   (number-of-chars	0)
 		   (reverse-chars		'()))
-	  (let ((ch (?read-char port who)))
-	    (cond ((eof-object? ch)
-		   (if (null? reverse-chars)
-		       ch
-		     (%reversed-chars->string number-of-chars reverse-chars)))
-		  ;;We are waiting for the end of line here.
-		  ((would-block-object? ch)
-		   (loop port number-of-chars reverse-chars))
-		  (else
-		   (let ((ch (%convert-if-line-ending eol-bits ch ?read-char ?peek-char)))
-		     (if ($char= ch LINEFEED-CHAR)
-			 (%reversed-chars->string number-of-chars reverse-chars)
-		       (loop port ($fxadd1 number-of-chars) (cons ch reverse-chars))))))))))
+	  (cond ((?read-run port)
+		 => (lambda (run)
+		      (loop port ($fx+ number-of-chars ($string-length run)) (cons run reverse-chars))))
+		(else
+		 (let ((ch (?read-char port who)))
+		   (cond ((eof-object? ch)
+			  (if (null? reverse-chars)
+			      ch
+			    (%reversed-chars->string number-of-chars reverse-chars)))
+			 ;;We are waiting for the end of line here.
+			 ((would-block-object? ch)
+			  (loop port number-of-chars reverse-chars))
+			 (else
+			  (let ((ch (%convert-if-line-ending eol-bits ch ?read-char ?peek-char)))
+			    (if ($char= ch LINEFEED-CHAR)
+				(%reversed-chars->string number-of-chars reverse-chars)
+			      (loop port ($fxadd1 number-of-chars) (cons ch reverse-chars))))))))))))
+
+    (define-syntax-rule (%no-bulk-decoding port)
+      #f)
 
     (define-syntax-rule (%convert-if-line-ending eol-bits ch ?read-char ?peek-char)
       (cond (($fxzero? eol-bits) ;EOL style none
@@ -1729,14 +2069,25 @@
 	    (else ch)))
 
     (define (%reversed-chars->string dst.len reverse-chars)
-      (let next-char ((dst.str       ($make-string dst.len))
-		      (dst.index     ($fxsub1 dst.len))
-		      (reverse-chars reverse-chars))
-	(if (null? reverse-chars)
-	    dst.str
-	  (begin
-	    ($string-set! dst.str dst.index (car reverse-chars))
-	    (next-char dst.str ($fxsub1 dst.index) (cdr reverse-chars))))))
+      (if (and (pair? reverse-chars)
+	       (null? (cdr reverse-chars))
+	       (string? (car reverse-chars)))
+	  ;;The whole line is a single run.
+	  (car reverse-chars)
+	(let next-char ((dst.str       ($make-string dst.len))
+			(dst.index     ($fxsub1 dst.len))
+			(reverse-chars reverse-chars))
+	  (cond ((null? reverse-chars)
+		 dst.str)
+		((char? (car reverse-chars))
+		 ($string-set! dst.str dst.index (car reverse-chars))
+		 (next-char dst.str ($fxsub1 dst.index) (cdr reverse-chars)))
+		(else
+		 (let* ((run		(car reverse-chars))
+			(run.len	($string-length run))
+			(run.start	($fx- ($fxadd1 dst.index) run.len)))
+		   ($string-copy!/count run 0 dst.str run.start run.len)
+		   (next-char dst.str ($fxsub1 run.start) (cdr reverse-chars))))))))
 
     (define-inline (%read-utf16le ?port ?who)
       (%read-char-from-port-with-fast-get-utf16xe-tag ?port ?who 'little))
@@ -2203,6 +2554,65 @@
 
     (main)))
 
+;;; --------------------------------------------------------------------
+;;; bulk decoding of ASCII runs
+
+;;Bit masks for  the "ikrt_bytevector_ascii_span()" kernel: bit N set  means that the
+;;octet N ends the run.
+;;
+(define ASCII-SPAN-STOP-AT-LINEFEED		(fxsll 1 LINEFEED-CODE-POINT))
+(define ASCII-SPAN-STOP-AT-CARRIAGE-RETURN	(fxsll 1 CARRIAGE-RETURN-CODE-POINT))
+
+(define-inline (%ascii-span-stop-set-for-eol-style port)
+  ;;When the port has an EOL style: #\return starts a sequence that must be converted,
+  ;;so it ends the run.  The other line ending characters are not ASCII.
+  ;;
+  (if (%port-eol-style-is-none? port)
+      0
+    ASCII-SPAN-STOP-AT-CARRIAGE-RETURN))
+
+(define (%decode-ascii-run-from-port-with-fast-get-utf8-tag port dst.str dst.index dst.past)
+  ;;PORT must be  a textual input port with bytevector buffer  and UTF-8 transcoder.
+  ;;Decode into DST.STR, from DST.INDEX to DST.PAST excluded, the run of ASCII octets
+  ;;at the current buffer index; the run  ends at the first non-ASCII octet, at the
+  ;;end of the buffered data or, when the port has an EOL style, at #\return.  Return
+  ;;the index in DST.STR one past the last decoded character.
+  ;;
+  ;;The whole run is validated and widened  by a C kernel, a word at a time, skipping
+  ;;the per-character codec dispatch.  No data is read from the device.
+  ;;
+  (with-port-having-bytevector-buffer (port)
+    (let* ((room	($fx- dst.past dst.index))
+	   (avail	($fx- port.buffer.used-size port.buffer.index))
+	   (end		($fx+ port.buffer.index (if ($fx< room avail) room avail))))
+      ;;A run of a single character is cheaper to decode in Scheme.
+      (if ($fx< ($fxadd1 port.buffer.index) end)
+	  (let ((run (foreign-call "ikrt_bytevector_ascii_span" port.buffer port.buffer.index end
+				   (%ascii-span-stop-set-for-eol-style port))))
+	    (foreign-call "ikrt_bytevector_widen_into" port.buffer port.buffer.index dst.str dst.index run)
+	    (port.buffer.index.incr! run)
+	    ($fx+ dst.index run))
+	dst.index))))
+
+(define (%read-ascii-line-run-from-port-with-fast-get-utf8-tag port)
+  ;;PORT must be  a textual input port with bytevector buffer  and UTF-8 transcoder.
+  ;;Like %DECODE-ASCII-RUN-FROM-PORT-WITH-FAST-GET-UTF8-TAG, but the run also ends at
+  ;;#\linefeed and it is returned as a new narrow string.  Return false if the run is
+  ;;shorter than two characters; in this case nothing is consumed.
+  ;;
+  (with-port-having-bytevector-buffer (port)
+    (let ((start	port.buffer.index)
+	  (end		port.buffer.used-size))
+      (and ($fx< ($fxadd1 start) end)
+	   (let ((run (foreign-call "ikrt_bytevector_ascii_span" port.buffer start end
+				    ($fxior ASCII-SPAN-STOP-AT-LINEFEED
+					    (%ascii-span-stop-set-for-eol-style port)))))
+	     (and ($fx> run 1)
+		  (let ((str ($make-narrow-string run)))
+		    (foreign-call "ikrt_bytevector_widen_into" port.buffer start str 0 run)
+		    (port.buffer.index.incr! run)
+		    str)))))))
+
 
 ;;;; GET-CHAR and LOOKAHEAD-CHAR for ports with UTF-16 transcoder
 
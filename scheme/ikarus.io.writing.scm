@@ -123,7 +123,8 @@
       (let ((buffer.used-size port.buffer.used-size))
 	(let try-again-after-partial-write ((buffer.offset 0))
 	  (let* ((requested-count ($fx- buffer.used-size buffer.offset))
-		 (written-count   (port.write! port.buffer buffer.offset requested-count)))
+		 (written-count   (%with-device-call-accounting (port write)
+				    (port.write! port.buffer buffer.offset requested-count))))
 	    (if (not (and (fixnum? written-count)
 			  ($fx>= written-count 0)
 			  ($fx<= written-count requested-count)))
@@ -138,7 +139,10 @@
 	      (cond (($fx= written-count buffer.used-size)
 		     ;;Full success, all data absorbed.
 		     (port.device.position.incr! written-count)
-		     (port.buffer.reset-to-empty!))
+		     (port.buffer.reset-to-empty!)
+		     (let ((stats (%port-stats port)))
+		       (when stats
+			 (%port-stats-after-flush! port stats buffer.used-size))))
 		    (($fxzero? written-count)
 		     ;;Failure, no data absorbed.  Try again.
 		     (try-again-after-partial-write buffer.offset))
@@ -152,7 +156,7 @@
 
 ;;;; byte and bytevector output
 
-(module (put-u8 put-bytevector)
+(module (put-u8 put-bytevector put-bytevectors)
 
   (define* (put-u8 port {octet fixnum-octet?})
     ;;Defined by R6RS.  Write OCTET to the output port and return unspecified values.
@@ -239,6 +243,339 @@
 						(port.buffer.room))))))
     (values))
 
+;;; --------------------------------------------------------------------
+
+  (define* (put-bytevectors port {slices list?})
+    ;;Write to  the binary output PORT the  octets selected by the list  SLICES, in
+    ;;order; each item must be a bytevector  or a list "(BV START COUNT)" selecting a
+    ;;portion of bytevector.  Return unspecified values.
+    ;;
+    ;;When PORT has a file descriptor as device and the data does not fit in the room
+    ;;left in the buffer: the buffered octets and  the slices are handed to a single
+    ;;"writev()" call, without copying the slices into the buffer.
+    ;;
+    (receive (vec total)
+	(%bytevector-slices->vector __who__ slices 0)
+      (%case-binary-output-port-fast-tag (port __who__)
+	((FAST-PUT-BYTE-TAG)
+	 (with-port-having-bytevector-buffer (port)
+	   (if (and port.fd-device?
+		    ($fx> total (port.buffer.room)))
+	       (%gather-write port vec __who__)
+	     (let loop ((idx 3))
+	       (when ($fx< idx ($vector-length vec))
+		 (let ((count ($vector-ref vec ($fx+ 2 idx))))
+		   (unless ($fxzero? count)
+		     (%put-bytevector port ($vector-ref vec idx) ($vector-ref vec ($fxadd1 idx))
+				      count __who__)))
+		 (loop ($fx+ 3 idx)))))))))
+    (values))
+
+  (define (%gather-write port vec who)
+    ;;Write  to the file descriptor  device of PORT the  octets in the buffer followed
+    ;;by the slices in the vector of triplets VEC; the first triplet is reserved for
+    ;;the buffer.  Loop until all the data is absorbed, like %FLUSH-OUTPUT-PORT does.
+    ;;
+    (with-port-having-bytevector-buffer (port)
+      (unless ($fx= port.buffer.index port.buffer.used-size)
+	;;The  port position was moved  back inside the buffer:  the data must go to the
+	;;device before the slices.
+	(%flush-output-port port who))
+      ($vector-set! vec 0 port.buffer)
+      ($vector-set! vec 2 port.buffer.used-size)
+      (let ((fd port.device))
+	(let next-write ((first 0) (skip 0) (count 0))
+	  (receive (first skip)
+	      (%bytevector-slices-advance vec first skip count)
+	    (if ($fx< first ($fxdiv ($vector-length vec) 3))
+		(let ((count (%with-device-call-accounting (port write)
+			       (capi::platform-writev-fd fd vec first skip))))
+		  (cond (($fx>= count 0)
+			 (port.device.position.incr! count)
+			 (next-write first skip count))
+			((and ($fx= count EAGAIN)
+			      (%wait-for-descriptor-readiness fd 'write))
+			 (next-write first skip 0))
+			(else
+			 ;;Discard from the buffer the octets already written, so that
+			 ;;the port is in a consistent state.
+			 (if ($fxzero? first)
+			     (let ((left ($fx- port.buffer.used-size skip)))
+			       ($bytevector-copy!/count port.buffer skip port.buffer 0 left)
+			       (set! port.buffer.index     left)
+			       (set! port.buffer.used-size left))
+			   (port.buffer.reset-to-empty!))
+			 (if ($fx= count EAGAIN)
+			     (%raise-eagain-error who port port.id)
+			   (%raise-io-error who port.id count (make-i/o-write-error))))))
+	      (port.buffer.reset-to-empty!)))))))
+
+  #| end of module |# )
+
+
+;;;; fixed-width numeric output
+
+(module (put-u16-native	put-u16-le	put-u16-be
+	 put-s16-native	put-s16-le	put-s16-be
+	 put-u32-native	put-u32-le	put-u32-be
+	 put-s32-native	put-s32-le	put-s32-be
+	 put-u64-native	put-u64-le	put-u64-be
+	 put-s64-native	put-s64-le	put-s64-be
+	 put-f32-native	put-f32-le	put-f32-be
+	 put-f64-native	put-f64-le	put-f64-be
+	 put-u32-vector	put-s32-vector	put-f64-vector)
+  ;;Defined by Vicare.   Encode fixed-width numeric fields straight  into the buffer
+  ;;of a binary output port, without building intermediate bytevectors.  Return
+  ;;unspecified values.
+  ;;
+  ;;The bulk putters write  the COUNT items of a vector starting  at index START; all
+  ;;the items are validated before any octet is written.
+  ;;
+  (define-syntax define-fixed-width-putter
+    (syntax-rules ()
+      ((_ ?who ?size ?pred ?unsafe-set!)
+       (define* (?who port {value ?pred})
+	 (%case-binary-output-port-fast-tag (port __who__)
+	   ((FAST-PUT-BYTE-TAG)
+	    (with-port-having-bytevector-buffer (port)
+	      (%flush-bytevector-buffer-and-evaluate (port __who__)
+		(room-is-needed-for: ?size)
+		(if-available-room:
+		 (let* ((buffer.index	port.buffer.index)
+			(buffer.past	($fx+ buffer.index ?size)))
+		   (?unsafe-set! port.buffer buffer.index value)
+		   (when ($fx< port.buffer.used-size buffer.past)
+		     (set! port.buffer.used-size buffer.past))
+		   (set! port.buffer.index buffer.past))))
+	      (when port.buffer-mode-none?
+		(%flush-output-port port __who__)))))
+	 (values)))
+      ))
+
+  (define-syntax define-fixed-width-vector-putter
+    (syntax-rules ()
+      ((_ ?who ?size ?pred ?unsafe-set!)
+       (define* (?who port {src.vec vector?} {src.start fixnum-start-index?} {count fixnum-count?} endianness)
+	 (assert-endianness endianness)
+	 (assert-start-index-for-vector src.vec src.start)
+	 (assert-count-from-start-index-for-vector src.vec src.start count)
+	 (let ((src.past ($fx+ src.start count)))
+	   (do ((src.index src.start ($fxadd1 src.index)))
+	       (($fx= src.index src.past))
+	     (unless (?pred ($vector-ref src.vec src.index))
+	       (procedure-arguments-consistency-violation __who__
+		 "vector item out of range for the field type"
+		 src.vec src.index ($vector-ref src.vec src.index))))
+	   (%case-binary-output-port-fast-tag (port __who__)
+	     ((FAST-PUT-BYTE-TAG)
+	      (with-port-having-bytevector-buffer (port)
+		(let next-chunk ((src.index src.start))
+		  (when ($fx< src.index src.past)
+		    (%flush-bytevector-buffer-and-evaluate (port __who__)
+		      (room-is-needed-for: ?size)
+		      (if-available-room:
+		       ;;Encode as many items as fit in the room left in the buffer.
+		       (let ((chunk.past ($fx+ src.index
+					       ($fxmin ($fx- src.past src.index)
+						       ($fxquotient ($fx- port.buffer.size port.buffer.index)
+								    ?size)))))
+			 (let next-field ((src.index    src.index)
+					  (buffer.index port.buffer.index))
+			   (if ($fx< src.index chunk.past)
+			       (begin
+				 (?unsafe-set! port.buffer buffer.index ($vector-ref src.vec src.index) endianness)
+				 (next-field ($fxadd1 src.index) ($fx+ buffer.index ?size)))
+			     (begin
+			       (when ($fx< port.buffer.used-size buffer.index)
+				 (set! port.buffer.used-size buffer.index))
+			       (set! port.buffer.index buffer.index)
+			       (next-chunk src.index)))))))))
+		(when port.buffer-mode-none?
+		  (%flush-output-port port __who__))))))
+	 (values)))
+      ))
+
+  (define (u16-value? obj)
+    (and (fixnum? obj)
+	 ($fx>= obj 0)
+	 ($fx<= obj #xFFFF)))
+
+  (define (s16-value? obj)
+    (and (fixnum? obj)
+	 ($fx>= obj -32768)
+	 ($fx<= obj +32767)))
+
+  (define (u32-value? obj)
+    (and (exact-integer? obj)
+	 (<= 0 obj #xFFFFFFFF)))
+
+  (define (s32-value? obj)
+    (and (exact-integer? obj)
+	 (<= #x-80000000 obj #x7FFFFFFF)))
+
+  (define (u64-value? obj)
+    (and (exact-integer? obj)
+	 (<= 0 obj #xFFFFFFFFFFFFFFFF)))
+
+  (define (s64-value? obj)
+    (and (exact-integer? obj)
+	 (<= #x-8000000000000000 obj #x7FFFFFFFFFFFFFFF)))
+
+  (define-fixed-width-putter put-u16-native	2 u16-value? $bytevector-u16n-set!)
+  (define-fixed-width-putter put-u16-le		2 u16-value? $bytevector-u16l-set!)
+  (define-fixed-width-putter put-u16-be		2 u16-value? $bytevector-u16b-set!)
+  (define-fixed-width-putter put-s16-native	2 s16-value? $bytevector-s16n-set!)
+  (define-fixed-width-putter put-s16-le		2 s16-value? $bytevector-s16l-set!)
+  (define-fixed-width-putter put-s16-be		2 s16-value? $bytevector-s16b-set!)
+
+  (define-fixed-width-putter put-u32-native	4 u32-value? $bytevector-u32n-set!)
+  (define-fixed-width-putter put-u32-le		4 u32-value? $bytevector-u32l-set!)
+  (define-fixed-width-putter put-u32-be		4 u32-value? $bytevector-u32b-set!)
+  (define-fixed-width-putter put-s32-native	4 s32-value? $bytevector-s32n-set!)
+  (define-fixed-width-putter put-s32-le		4 s32-value? $bytevector-s32l-set!)
+  (define-fixed-width-putter put-s32-be		4 s32-value? $bytevector-s32b-set!)
+
+  (define-fixed-width-putter put-u64-native	8 u64-value? $bytevector-u64n-set!)
+  (define-fixed-width-putter put-u64-le		8 u64-value? $bytevector-u64l-set!)
+  (define-fixed-width-putter put-u64-be		8 u64-value? $bytevector-u64b-set!)
+  (define-fixed-width-putter put-s64-native	8 s64-value? $bytevector-s64n-set!)
+  (define-fixed-width-putter put-s64-le		8 s64-value? $bytevector-s64l-set!)
+  (define-fixed-width-putter put-s64-be		8 s64-value? $bytevector-s64b-set!)
+
+  (define-fixed-width-putter put-f32-native	4 flonum? $bytevector-ieee-single-native-set!)
+  (define-fixed-width-putter put-f32-le		4 flonum? $bytevector-ieee-single-little-set!)
+  (define-fixed-width-putter put-f32-be		4 flonum? $bytevector-ieee-single-big-set!)
+
+  (define-fixed-width-putter put-f64-native	8 flonum? $bytevector-ieee-double-native-set!)
+  (define-fixed-width-putter put-f64-le		8 flonum? $bytevector-ieee-double-little-set!)
+  (define-fixed-width-putter put-f64-be		8 flonum? $bytevector-ieee-double-big-set!)
+
+  (define-fixed-width-vector-putter put-u32-vector	4 u32-value? $bytevector-u32-set!)
+  (define-fixed-width-vector-putter put-s32-vector	4 s32-value? $bytevector-s32-set!)
+  (define-fixed-width-vector-putter put-f64-vector	8 flonum?    $bytevector-ieee-double-set!)
+
+  #| end of module: fixed-width numeric output |# )
+
+
+;;;; transferring data between ports
+
+(module (transfer-port-contents)
+
+  (define-constant TRANSFER-CHUNK-SIZE
+    ;;Maximum number of octets requested to a single system call; it is a fixnum
+    ;;on 32-bit platforms, too.
+    #x10000000)
+
+  (define-false-or-predicate false-or-count?	non-negative-exact-integer?)
+
+  (case-define* transfer-port-contents
+    ;;Read octets from the binary input SRC-PORT  and write them to the binary output
+    ;;DST-PORT until the end of file or until  COUNT octets have been transferred, if
+    ;;COUNT  is  non-false.   Return  the  number  of  octets  transferred,  or  the
+    ;;would-block object if a non-blocking device cannot absorb or provide data and no
+    ;;octet was transferred.
+    ;;
+    ;;The octets already in  the buffer of SRC-PORT are written  first; then, if both
+    ;;ports have a file descriptor as device, DST-PORT's buffer is flushed and the data
+    ;;is moved inside the kernel with "copy_file_range()", "sendfile()" or "splice()",
+    ;;whichever accepts the descriptors.   Otherwise, or if no system call accepts the
+    ;;descriptors: the data goes through the buffer of SRC-PORT.
+    ;;
+    ((src-port dst-port)
+     (transfer-port-contents src-port dst-port #f))
+    (({src-port open-binary-input-port?} {dst-port open-binary-output-port?} {count false-or-count?})
+     (%case-binary-input-port-fast-tag (src-port __who__)
+       ((FAST-GET-BYTE-TAG)
+	(%case-binary-output-port-fast-tag (dst-port __who__)
+	  ((FAST-PUT-BYTE-TAG)
+	   (%transfer src-port dst-port count __who__)))))))
+
+  (define (%transfer src dst limit who)
+    (with-port-having-bytevector-buffer (src)
+      (let* ((avail	($fx- src.buffer.used-size src.buffer.index))
+	     (count	(if (and limit (< limit avail)) limit avail)))
+	;;Consume the octets already in the source buffer.
+	(unless ($fxzero? count)
+	  (put-bytevector dst src.buffer src.buffer.index count)
+	  (src.buffer.index.incr! count))
+	(let* ((limit	(and limit (- limit count)))
+	       (rv	(cond ((and limit (zero? limit))
+			       0)
+			      ((and src.fd-device?
+				    (not src.read-ahead?)
+				    ($port-with-fd-device? dst))
+			       (%flush-output-port dst who)
+			       (%kernel-transfer src dst limit who))
+			      (else
+			       (%buffered-transfer src dst limit who)))))
+	  (if (would-block-object? rv)
+	      (if ($fxzero? count) rv count)
+	    (+ count rv))))))
+
+  (define (%kernel-transfer src dst limit who)
+    ;;Both  the ports have a file descriptor as device, SRC's buffer is empty and DST's
+    ;;buffer has been flushed.  Try the system calls in order: 0 = copy_file_range(), 1
+    ;;= sendfile(), 2 = splice().
+    ;;
+    (with-port (src)
+      (with-port (dst)
+	(let next-chunk ((method 0) (total 0))
+	  (if (and limit (= total limit))
+	      total
+	    (let ((rv (%with-device-call-accounting (dst write)
+			(%with-device-call-accounting (src read)
+			  (capi::platform-transfer-fd method src.device dst.device
+						      (if (and limit (< (- limit total) TRANSFER-CHUNK-SIZE))
+							  (- limit total)
+							TRANSFER-CHUNK-SIZE))))))
+	      (cond (($fxpositive? rv)
+		     (src.device.position.incr! rv)
+		     (dst.device.position.incr! rv)
+		     (next-chunk method (+ total rv)))
+		    (($fxzero? rv)
+		     ;;End of file.
+		     total)
+		    (else
+		     (case-errno rv
+		       ((ENOSYS EINVAL EXDEV EOPNOTSUPP)
+			;;This system call cannot handle these descriptors.
+			(if ($fx< method 2)
+			    (next-chunk ($fxadd1 method) total)
+			  (let ((rv (%buffered-transfer src dst (and limit (- limit total)) who)))
+			    (if (would-block-object? rv)
+				(if (zero? total) rv total)
+			      (+ total rv)))))
+		       ((EAGAIN)
+			(if (zero? total) WOULD-BLOCK-OBJECT total))
+		       (else
+			(%raise-io-error who src.id rv (make-i/o-error))))))))))))
+
+  (define (%buffered-transfer src dst limit who)
+    ;;Move the data through the buffer of SRC.
+    ;;
+    (with-port-having-bytevector-buffer (src)
+      (let next-buffer ((total 0))
+	(define (consume)
+	  (let* ((avail	($fx- src.buffer.used-size src.buffer.index))
+		 (count	(if (and limit (< (- limit total) avail))
+			    (- limit total)
+			  avail)))
+	    (put-bytevector dst src.buffer src.buffer.index count)
+	    (src.buffer.index.incr! count)
+	    (next-buffer (+ total count))))
+	(if (and limit (= total limit))
+	    total
+	  (maybe-refill-bytevector-buffer-and-evaluate (src who)
+	    (data-is-needed-at: src.buffer.index)
+	    (if-end-of-file:
+	     total)
+	    (if-empty-buffer-and-refilling-would-block:
+	     (if (zero? total) WOULD-BLOCK-OBJECT total))
+	    (if-successful-refill:
+	     (consume))
+	    (if-available-data:
+	     (consume)))))))
+
   #| end of module |# )
 
 
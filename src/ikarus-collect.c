@@ -49,7 +49,8 @@
 #define meta_weak	3
 #define meta_pair	4
 #define meta_symbol	5
-#define meta_count	6
+#define meta_ephemeron	6
+#define meta_count	7
 
 
 /** --------------------------------------------------------------------
@@ -109,6 +110,13 @@ typedef struct gc_t {
   ikptr_t		tconc_base;
   ikmemblock_t *	tconc_queue;
   ik_ptr_page_t *	forward_list;
+
+  /* Simply linked list of nodes referencing the ephemerons pages to be
+     examined by "collect_loop_and_ephemerons()" and "fix_ephemerons()":
+     the pages allocated in this run to hold the moved ephemeron pairs.
+     The first node always references  the current ephemerons meta page
+     and its "q" field is kept equal to the meta page alloc pointer. */
+  qupages_t *	ephemeron_pages;
 } gc_t;
 
 
@@ -123,6 +131,7 @@ static void	handle_guardians	(gc_t* gc);
 
 static void	collect_stack(gc_t*, ikptr_t top, ikptr_t base);
 static void	collect_loop(gc_t*);
+static void	collect_loop_and_ephemerons (gc_t* gc);
 
 static void	ik_munmap_from_segment (ikptr_t base, ikuword_t size, ikpcb_t* pcb);
 
@@ -135,11 +144,16 @@ static ikpcb_t *perform_garbage_collection (ikuword_t mem_req, ikptr_t s_request
 /* Prototypes for subroutines of "perform_garbage_collection()". */
 static int		collection_id_to_gen	(int id);
 static void		fix_weak_pointers	(gc_t *gc);
+static void		fix_ephemerons		(gc_t *gc);
+static void		scan_widened_strings	(gc_t *gc);
+static void		fix_widened_strings	(gc_t *gc);
 static inline void	collect_locatives	(gc_t*, ik_callback_locative_t*);
 static void		deallocate_unused_pages	(gc_t*);
 static void		fix_new_pages		(gc_t* gc);
 static void		gc_finalize_guardians	(gc_t* gc);
 static void		gc_add_tconcs		(gc_t*);
+static ik_ptr_page_t *	move_tconc		(ikptr_t tc, ik_ptr_page_t* ls);
+static inline int	next_gen		(int i);
 
 /* The function "gather_live_object_proc()" is the one that moves a live
    Scheme object from its pre-GC location to its after-GC location.  The
@@ -188,7 +202,8 @@ static const unsigned int META_MT[meta_count] = {
   DATA_MT,
   WEAK_PAIRS_MT,
   POINTERS_MT,
-  SYMBOLS_MT
+  SYMBOLS_MT,
+  EPHEMERONS_MT
 };
 
 /* ------------------------------------------------------------------ */
@@ -585,10 +600,13 @@ perform_garbage_collection (ikuword_t mem_req, ikptr_t s_requested_generation, i
     if (pcb->root7) *(pcb->root7) = gather_live_object(&gc, *(pcb->root7), "root7");
     if (pcb->root8) *(pcb->root8) = gather_live_object(&gc, *(pcb->root8), "root8");
     if (pcb->root9) *(pcb->root9) = gather_live_object(&gc, *(pcb->root9), "root9");
+
+    scan_widened_strings(&gc);
   }
 
-  /* Trace all live objects. */
-  collect_loop(&gc);
+  /* Trace all live objects,  including the cdrs of the ephemeron pairs
+     whose car is alive. */
+  collect_loop_and_ephemerons(&gc);
 
   /* Next  all  guardian/guarded   objects.   "handle_guadians()"  calls
      "collect_loop()" in its body. */
@@ -598,11 +616,13 @@ perform_garbage_collection (ikuword_t mem_req, ikptr_t s_requested_generation, i
   ik_debug_message("finished scan of GC roots");
 #endif
 
-  collect_loop(&gc);
+  collect_loop_and_ephemerons(&gc);
 
   /* Does  not  allocate,  only  sets  to  BWP  the  locations  of  dead
      pointers. */
   fix_weak_pointers(&gc);
+  fix_ephemerons(&gc);
+  fix_widened_strings(&gc);
 
   /* Now deallocate all unused pages. */
   deallocate_unused_pages(&gc);
@@ -617,6 +637,8 @@ perform_garbage_collection (ikuword_t mem_req, ikptr_t s_requested_generation, i
 #endif
   pcb->weak_pairs_ap = 0;
   pcb->weak_pairs_ep = 0;
+  pcb->ephemerons_ap = 0;
+  pcb->ephemerons_ep = 0;
 
 #if ACCOUNTING
 #if ((defined VICARE_DEBUGGING) && (defined VICARE_DEBUGGING_GC))
@@ -818,6 +840,102 @@ fix_weak_pointers (gc_t* gc)
   }
 }
 static void
+fix_ephemerons (gc_t* gc)
+/* Subroutine  of  "perform_garbage_collection()".   Fix the  cars  and
+   cdrs of the ephemeron pairs moved  during this run; release the list
+   of ephemerons pages.
+
+     When  we are  here "collect_loop_and_ephemerons()"  has already
+   gathered the cdr of  every ephemeron whose car is alive.   So: if the
+   car has been  moved, store its new  location in the car  slot; if the
+   car is dead, set both the car and the cdr slots to the BWP object.
+
+     Ephemerons in  dirty pages of older  generations are not examined
+   here: like the weak pairs, they are scanned by "scan_dirty_pages()"
+   as if they were strong pairs. */
+{
+  qupages_t *	qu = gc->ephemeron_pages;
+  gc->ephemeron_pages = NULL;
+  while (qu) {
+    ikptr_t	p = qu->p;
+    ikptr_t	q = qu->q;
+    for (; p < q; p += pair_size) {
+      ikptr_t X = IK_REF(p, disp_car);
+      if (! (IK_IS_FIXNUM(X) || (IK_TAGOF(X) == immediate_tag))) {
+	int tag = IK_TAGOF(X);
+	if (IK_FORWARD_PTR == IK_REF(X, disp_1st_word-tag)) {
+	  /* The car is alive and it has been moved. */
+	  IK_REF(p, disp_car) = IK_REF(X, disp_2nd_word-tag);
+	} else if ((gc->segment_vector[IK_PAGE_INDEX(X)] & GEN_MASK) <= gc->collect_gen) {
+	  /* The car is dead: break the ephemeron. */
+	  IK_REF(p, disp_car) = IK_BWP_OBJECT;
+	  IK_REF(p, disp_cdr) = IK_BWP_OBJECT;
+	}
+      }
+    }
+    {
+      qupages_t *	next = qu->next;
+      ik_free(qu, sizeof(qupages_t));
+      qu = next;
+    }
+  }
+}
+static void
+scan_widened_strings (gc_t* gc)
+/* Subroutine of "perform_garbage_collection()".  Gather the wide strings
+   referenced by the widened strings  in the generations that are not
+   collected in this run; such  strings do not move, but the referenced
+   wide strings may. */
+{
+  ikpcb_t *	pcb = gc->pcb;
+  int		gen;
+  for (gen=gc->collect_gen+1; gen<IK_GC_GENERATION_COUNT; ++gen) {
+    ik_ptr_page_t *	ls;
+    for (ls = pcb->widened_strings[gen]; ls; ls = ls->next) {
+      int	i;
+      for (i=0; i<ls->count; ++i) {
+	ikptr_t	s_str = ls->ptr[i];
+	IK_REF(s_str, off_string_data) =
+	  gather_live_object(gc, IK_REF(s_str, off_string_data), "widened string");
+      }
+    }
+  }
+}
+static void
+fix_widened_strings (gc_t* gc)
+/* Subroutine of "perform_garbage_collection()".  Update the lists of
+   widened strings in the collected generations: the strings that have
+   been moved are registered, with their new address, in the generation
+   they have been moved to; the dead strings are dropped.  Must be called
+   before the old pages are released. */
+{
+  ikpcb_t *		pcb        = gc->pcb;
+  int			target_gen = next_gen(gc->collect_gen);
+  /* When collecting the oldest generation the target list is one of the
+     lists we are fixing, so it is rebuilt from scratch. */
+  ik_ptr_page_t *	target = (target_gen > gc->collect_gen)? pcb->widened_strings[target_gen] : NULL;
+  int			gen;
+  for (gen=0; gen<=gc->collect_gen; ++gen) {
+    ik_ptr_page_t *	ls = pcb->widened_strings[gen];
+    pcb->widened_strings[gen] = NULL;
+    while (ls) {
+      int	i;
+      for (i=0; i<ls->count; ++i) {
+	ikptr_t	s_str = ls->ptr[i];
+	if (IK_FORWARD_PTR == IK_REF(s_str, disp_1st_word - string_tag)) {
+	  target = move_tconc(IK_REF(s_str, disp_2nd_word - string_tag), target);
+	}
+      }
+      {
+	ik_ptr_page_t *	next = ls->next;
+	ik_munmap((ikptr_t)ls, IK_PAGESIZE);
+	ls = next;
+      }
+    }
+  }
+  pcb->widened_strings[target_gen] = target;
+}
+static void
 deallocate_unused_pages (gc_t* gc)
 /* Subroutine of "perform_garbage_collection()". */
 {
@@ -1257,9 +1375,7 @@ add_one_tconc(ikpcb_t* pcb, ikptr_t p)
  ** Collection subroutines: guardians handling.
  ** ----------------------------------------------------------------- */
 
-static ik_ptr_page_t *	move_tconc (ikptr_t tc, ik_ptr_page_t* ls);
 static inline int	is_live (ikptr_t x, gc_t* gc);
-static inline int	next_gen (int i);
 
 static void
 handle_guardians (gc_t* gc)
@@ -1342,7 +1458,7 @@ handle_guardians (gc_t* gc)
 	  ik_munmap((ikptr_t)ls, IK_PAGESIZE);
 	  ls = next;
 	}
-	collect_loop(gc);
+	collect_loop_and_ephemerons(gc);
       }
     }
   }
@@ -1373,7 +1489,7 @@ handle_guardians (gc_t* gc)
     ik_munmap((ikptr_t)pend_hold_list, IK_PAGESIZE);
     pend_hold_list = next;
   }
-  collect_loop(gc);
+  collect_loop_and_ephemerons(gc);
   pcb->protected_list[next_gen(gc->collect_gen)] = target;
 }
 static inline int
@@ -1429,6 +1545,7 @@ static inline void	enqueue_large_ptr	(ikptr_t mem, ikuword_t aligned_size, gc_t*
 static inline ikptr_t	gc_alloc_new_symbol_record (gc_t* gc);
 static inline ikptr_t	gc_alloc_new_pair	(gc_t* gc);
 static inline ikptr_t	gc_alloc_new_weak_pair	(gc_t* gc);
+static inline ikptr_t	gc_alloc_new_ephemeron	(gc_t* gc);
 static inline ikptr_t	gc_alloc_new_code	(ikuword_t aligned_size, gc_t* gc);
 
 static ikptr_t
@@ -2023,22 +2140,53 @@ gather_live_object_proc (gc_t* gc, ikptr_t X)
   } /* end of "case vector_tag:" */
 
   case string_tag: {
-    if (IK_IS_FIXNUM(first_word)) {
-      ikuword_t	len    = IK_UNFIX(first_word);
-      ikuword_t	memreq = IK_ALIGN(len * IK_STRING_CHAR_SIZE + disp_string_data);
-      ikptr_t	Y      = gc_alloc_new_data(memreq, gc) | string_tag;
+    /* The first word is  the length fixnum with the representation in
+       its least significant bits; see "IK_STRING_REPR()". */
+    ikuword_t	len  = IK_UNFIX(first_word);
+    ikptr_t	Y;
+    switch (IK_STRING_REPR_MASK & first_word) {
+    case IK_STRING_WIDE: {
+      ikuword_t	memreq = IK_WIDE_STRING_SIZE(len);
+      Y = gc_alloc_new_data(memreq, gc) | string_tag;
       IK_REF(Y, off_string_length) = first_word;
       memcpy((uint8_t*)(ikuword_t)(Y + off_string_data),
              (uint8_t*)(ikuword_t)(X + off_string_data),
              len * IK_STRING_CHAR_SIZE);
+      break;
+    }
+    case IK_STRING_NARROW: {
+      ikuword_t	memreq = IK_NARROW_STRING_SIZE(len);
+      Y = gc_alloc_new_data(memreq, gc) | string_tag;
+      IK_REF(Y, off_string_length) = first_word;
+      memcpy((uint8_t*)(ikuword_t)(Y + off_string_data),
+             (uint8_t*)(ikuword_t)(X + off_string_data),
+             len);
+      break;
+    }
+    case IK_STRING_WIDENED: {
+      /* The copy keeps the narrow size; the wide string it references is
+	 gathered here, the fix phase registers the copy. */
+      ikuword_t	memreq = IK_NARROW_STRING_SIZE(len);
+      ikptr_t	s_wide = IK_REF(X, off_string_data);
+      Y = gc_alloc_new_data(memreq, gc) | string_tag;
+      IK_REF(Y, off_string_length) = first_word;
       IK_REF(X, disp_1st_word - string_tag) = IK_FORWARD_PTR;
       IK_REF(X, disp_2nd_word - string_tag) = Y;
+      IK_REF(Y, off_string_data) = gather_live_object(gc, s_wide, "widened string");
 #if ACCOUNTING
       string_count++;
 #endif
       return Y;
-    } else
-      ik_abort("unhandled string 0x%016lx with first_word=0x%016lx\n", (long)X, (long)first_word);
+    }
+    default:
+      return ik_abort("unhandled string 0x%016lx with first_word=0x%016lx\n", (long)X, (long)first_word);
+    }
+    IK_REF(X, disp_1st_word - string_tag) = IK_FORWARD_PTR;
+    IK_REF(X, disp_2nd_word - string_tag) = Y;
+#if ACCOUNTING
+    string_count++;
+#endif
+    return Y;
   }
 
   case bytevector_tag: {
@@ -2090,6 +2238,18 @@ gather_live_list (gc_t* gc, uint32_t page_sbits, ikptr_t X, ikptr_t* loc)
     ikptr_t second_word     = IK_CDR(X);
     int   second_word_tag = IK_TAGOF(second_word);
     ikptr_t Y;
+    if (EPHEMERONS_TYPE == (page_sbits & TYPE_MASK)) {
+      /* X is an ephemeron: move it  without gathering its car nor its
+	 cdr.   The   cdr  is  gathered  later   by  "collect_loop_and_
+	 ephemerons()", only if the car is alive. */
+      Y = gc_alloc_new_ephemeron(gc) | pair_tag;
+      *loc = Y;
+      IK_CAR(X) = IK_FORWARD_PTR;
+      IK_CDR(X) = Y;
+      IK_CAR(Y) = first_word;
+      IK_CDR(Y) = second_word;
+      return;
+    }
     if ((page_sbits & TYPE_MASK) != WEAK_PAIRS_TYPE)
       Y = gc_alloc_new_pair(gc)      | pair_tag;
     else
@@ -2576,6 +2736,42 @@ gc_alloc_new_weak_pair(gc_t* gc)
   }
 }
 static inline ikptr_t
+gc_alloc_new_ephemeron (gc_t* gc)
+/* Reserve enough room in the current meta page for ephemerons to hold a
+   Scheme ephemeron pair object.  Return an untagged pointer to the first
+   word of reserved memory.
+
+     This  is like  "gc_alloc_new_weak_pair()", but  we also  register
+   every new meta page in the "ephemeron_pages" list of the GC struct, so
+   that "collect_loop_and_ephemerons()" can find the moved ephemerons. */
+{
+  meta_t *	meta = &gc->meta[meta_ephemeron];
+  ikptr_t	ap   = meta->ap;		/* meta page alloc pointer */
+  ikptr_t	ep   = meta->ep;		/* meta page end pointer */
+  ikptr_t	nap  = ap + pair_size;	/* meta page new alloc pointer */
+  if (nap > ep) {
+    ikptr_t	mem = ik_mmap_typed(IK_PAGESIZE, META_MT[meta_ephemeron] | gc->collect_gen_tag, gc->pcb);
+    qupages_t *	qu  = ik_malloc(sizeof(qupages_t));
+    /* Retake   the  segments   vector  because   memory  allocated   by
+       "ik_mmap_typed()" might have caused  the reallocation of the page
+       vectors. */
+    gc->segment_vector = gc->pcb->segment_vector;
+    meta->ap   = mem + pair_size;
+    meta->aq   = mem;
+    meta->ep   = mem + IK_PAGESIZE;
+    meta->base = mem;
+    qu->p      = mem;
+    qu->q      = mem + pair_size;
+    qu->next   = gc->ephemeron_pages;
+    gc->ephemeron_pages = qu;
+    return mem;
+  } else {
+    meta->ap = nap;
+    gc->ephemeron_pages->q = nap;
+    return ap;
+  }
+}
+static inline ikptr_t
 gc_alloc_new_data (ikuword_t aligned_size, gc_t* gc)
 /* Reserve enough room in  the current meta page for raw  data to hold a
    data area of  ALIGNED_SIZE bytes.  Return an untagged  pointer to the
@@ -2652,6 +2848,7 @@ meta_alloc_extending (ikuword_t aligned_size, gc_t* gc, int meta_id)
     1 * IK_PAGESIZE,
     1 * IK_PAGESIZE,
     1 * IK_PAGESIZE,
+    1 * IK_PAGESIZE,
   };
   ikuword_t	mapsize;
   meta_t *	meta;
@@ -2948,6 +3145,40 @@ collect_loop (gc_t* gc)
     }
   }
 }
+static void
+collect_loop_and_ephemerons (gc_t* gc)
+/* Like "collect_loop()", but also iterate to a fixpoint the tracing of
+   ephemerons: the cdr of an ephemeron pair is kept alive only if its
+   car is  alive.  Gathering  a cdr  can make  alive the  car of  another
+   ephemeron, so we loop until no more cdrs are gathered.
+
+     An ephemeron  whose  cdr has already been  gathered in  a previous
+   iteration   is   recognised   because    "gather_live_object()"   on
+   an already moved object returns the object itself. */
+{
+  int	changed;
+  do {
+    qupages_t *	qu;
+    collect_loop(gc);
+    changed = 0;
+    for (qu = gc->ephemeron_pages; qu; qu = qu->next) {
+      ikptr_t	p;
+      /* Notice that the  "q" field of the first node  might be updated
+	 while we gather: we always reload it. */
+      for (p = qu->p; p < qu->q; p += pair_size) {
+	ikptr_t	X = IK_REF(p, disp_car);
+	ikptr_t	D = IK_REF(p, disp_cdr);
+	if (is_live(X, gc) && !(IK_IS_FIXNUM(D) || (IK_TAGOF(D) == immediate_tag))) {
+	  ikptr_t	Y = gather_live_object(gc, D, "ephemeron");
+	  if (Y != D) {
+	    IK_REF(p, disp_cdr) = Y;
+	    changed = 1;
+	  }
+	}
+      }
+    }
+  } while (changed);
+}
 
 
 /** --------------------------------------------------------------------
@@ -3050,6 +3281,13 @@ scan_dirty_pages (gc_t* gc)
           dirty_vec   = (uint32_t*)pcb->dirty_vector;
           segment_vec = pcb->segment_vector;
         }
+        else if (type == EPHEMERONS_TYPE) {
+	  /* Like weak pairs:  ephemerons in dirty pages  of older generations
+	     are conservatively handled as strong pairs. */
+          scan_dirty_pointers_page(gc, page_idx, mask);
+          dirty_vec   = (uint32_t*)pcb->dirty_vector;
+          segment_vec = pcb->segment_vector;
+        }
         else if (type == CODE_TYPE) {
           scan_dirty_code_page(gc, page_idx);
           dirty_vec   = (uint32_t*)pcb->dirty_vector;
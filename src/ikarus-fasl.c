@@ -349,7 +349,7 @@ do_read (ikpcb_t * pcb, fasl_port_t* p)
       ik_debug_message("string length: %ld", (long)num_of_chars);
     mem_size	= IK_ALIGN(num_of_chars * IK_STRING_CHAR_SIZE + disp_string_data);
     s_str	= ik_unsafe_alloc(pcb, mem_size) | string_tag;
-    IK_STRING_LENGTH_FX(s_str) = IK_FIX(num_of_chars);
+    IK_STRING_HEADER(s_str) = IK_FIX(num_of_chars);
     ascii_data	= IK_STRING_DATA_VOIDP(s_str);
     fasl_read_buf(p, ascii_data, num_of_chars);
     if (0 || DEBUG_FASL) {
@@ -389,6 +389,24 @@ do_read (ikpcb_t * pcb, fasl_port_t* p)
       ik_debug_message("close %d: ascii string object", --object_count);
     return s_str;
   }
+  else if (c == 'n') {	/* narrow string */
+    /* The octets are the code points of the characters, stored as they are
+       in a narrow string.  Unlike ASCII strings, these are never read by a
+       boot image predating narrow strings. */
+    if (DEBUG_FASL)
+      ik_debug_message("open %d: narrow string object", object_count++);
+    ikuword_t	num_of_chars = 0;
+    ikptr_t	s_str;
+    fasl_read_buf(p, &num_of_chars, sizeof(ikuword_t));
+    s_str	= iku_narrow_string_alloc(pcb, num_of_chars);
+    fasl_read_buf(p, IK_STRING_DATA_UINT8P(s_str), num_of_chars);
+    if (put_mark_index) {
+      p->marks[put_mark_index] = s_str;
+    }
+    if (DEBUG_FASL)
+      ik_debug_message("close %d: narrow string object", --object_count);
+    return s_str;
+  }
   else if (c == 'S') {    /* Unicode string */
     if (DEBUG_FASL) ik_debug_message("open %d: string object", object_count++);
     ikuword_t	num_of_chars = 0;
@@ -397,7 +415,7 @@ do_read (ikpcb_t * pcb, fasl_port_t* p)
     fasl_read_buf(p, &num_of_chars, sizeof(ikuword_t));
     mem_size	= IK_ALIGN(num_of_chars*IK_STRING_CHAR_SIZE + disp_string_data);
     s_str	= ik_unsafe_alloc(pcb, mem_size) | string_tag;
-    IK_STRING_LENGTH_FX(s_str) = IK_FIX(num_of_chars);
+    IK_STRING_HEADER(s_str) = IK_FIX(num_of_chars);
     for (iksword_t i=0; i<num_of_chars; ++i) {
       ikchar_t	ch = 0;
       fasl_read_buf(p, &ch, sizeof(ikchar_t));
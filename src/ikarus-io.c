@@ -30,6 +30,15 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/uio.h>
+#include <limits.h>
+#include <time.h>
+#ifdef HAVE_SYS_SENDFILE_H
+#  include <sys/sendfile.h>
+#endif
+#if ((defined HAVE_SYS_EPOLL_H) && (defined HAVE_EPOLL_CREATE1))
+#  include <sys/epoll.h>
+#  define IK_HAVE_IO_POLLER	1
+#endif
 
 /* file descriptors */
 #define IK_FD_TO_NUM(fd)		IK_FIX(fd)
@@ -189,6 +198,131 @@ ikrt_write_fd (ikptr_t fd, ikptr_t buffer_bv, ikptr_t buffer_offset, ikptr_t req
   return (0 <= rv)? IK_FIX(rv) : ik_errno_to_code();
 }
 
+
+/** --------------------------------------------------------------------
+ ** File descriptors handling for Scheme ports: scatter reading and gather writing.
+ ** ----------------------------------------------------------------- */
+
+/* S_SLICES is a Scheme vector holding triplets of items:
+
+     #(bv0 start0 count0 bv1 start1 count1 ...)
+
+   each triplet selects the COUNT octets of the bytevector BV starting at
+   offset START;  the arguments have already been validated by the Scheme
+   code.  S_FIRST is the index of the first  triplet to be used, S_SKIP is
+   the number of octets of the first triplet already transferred.  The
+   returned value is the number of octets transferred, possibly less than
+   requested, or a negative fixnum representing an ERRNO code. */
+
+#ifdef IOV_MAX
+#  define IK_SLICES_MAX_IOVEC	IOV_MAX
+#else
+#  define IK_SLICES_MAX_IOVEC	1024
+#endif
+
+static int
+ik_slices_to_iovec (ikptr_t s_slices, ikptr_t s_first, ikptr_t s_skip, struct iovec * iov)
+{
+  long		number_of_items = IK_VECTOR_LENGTH(s_slices);
+  long		i		= 3 * IK_UNFIX(s_first);
+  long		skip		= IK_UNFIX(s_skip);
+  int		count		= 0;
+  for (; (i < number_of_items) && (count < IK_SLICES_MAX_IOVEC); i += 3, skip = 0) {
+    ikptr_t	s_bv	= IK_ITEM(s_slices, i);
+    long	start	= IK_UNFIX(IK_ITEM(s_slices, i+1)) + skip;
+    long	len	= IK_UNFIX(IK_ITEM(s_slices, i+2)) - skip;
+    if (0 < len) {
+      iov[count].iov_base = ((uint8_t *)IK_BYTEVECTOR_DATA_VOIDP(s_bv)) + start;
+      iov[count].iov_len  = len;
+      ++count;
+    }
+  }
+  return count;
+}
+ikptr_t
+ikrt_readv_fd (ikptr_t fd, ikptr_t s_slices, ikptr_t s_first, ikptr_t s_skip /*, ikpcb_t* pcb */)
+{
+  struct iovec	iov[IK_SLICES_MAX_IOVEC];
+  int		count = ik_slices_to_iovec(s_slices, s_first, s_skip, iov);
+  ssize_t	rv;
+  if (0 == count)
+    return IK_FIX(0);
+  errno = 0;
+  rv    = readv(IK_NUM_TO_FD(fd), iov, count);
+  return (0 <= rv)? IK_FIX(rv) : ik_errno_to_code();
+}
+ikptr_t
+ikrt_writev_fd (ikptr_t fd, ikptr_t s_slices, ikptr_t s_first, ikptr_t s_skip /*, ikpcb_t* pcb */)
+{
+  struct iovec	iov[IK_SLICES_MAX_IOVEC];
+  int		count = ik_slices_to_iovec(s_slices, s_first, s_skip, iov);
+  ssize_t	rv;
+  if (0 == count)
+    return IK_FIX(0);
+  errno = 0;
+  rv    = writev(IK_NUM_TO_FD(fd), iov, count);
+  return (0 <= rv)? IK_FIX(rv) : ik_errno_to_code();
+}
+
+
+/** --------------------------------------------------------------------
+ ** File descriptors handling for Scheme ports: transferring data in the kernel.
+ ** ----------------------------------------------------------------- */
+
+/* Transfer at most S_COUNT octets from the file descriptor S_SRC_FD to the file
+   descriptor S_DST_FD without copying them  to user space, using the current
+   file offsets of both descriptors.  S_METHOD selects the system call:
+
+   0 - copy_file_range(), both descriptors referencing regular files;
+   1 - sendfile(), the source descriptor referencing a memory-mappable file;
+   2 - splice(), one of the descriptors referencing a pipe.
+
+   Return  a non-negative fixnum representing the  number of octets actually
+   transferred,  zero  meaning end of file; else  return a negative fixnum
+   representing an ERRNO code.  When the selected system call is not available
+   or cannot handle the descriptors: the  returned code is ENOSYS, EINVAL,
+   EXDEV or EOPNOTSUPP and the caller should try another method. */
+
+ikptr_t
+ikrt_transfer_fd (ikptr_t s_method, ikptr_t s_src_fd, ikptr_t s_dst_fd, ikptr_t s_count /*, ikpcb_t* pcb */)
+{
+  IK_UNUSED int		src   = IK_NUM_TO_FD(s_src_fd);
+  IK_UNUSED int		dst   = IK_NUM_TO_FD(s_dst_fd);
+  IK_UNUSED size_t	count = IK_UNFIX(s_count);
+  ssize_t	rv;
+  errno = 0;
+  switch (IK_UNFIX(s_method)) {
+  case 0:
+#ifdef HAVE_COPY_FILE_RANGE
+    rv = copy_file_range(src, NULL, dst, NULL, count, 0);
+#else
+    errno = ENOSYS;
+    rv    = -1;
+#endif
+    break;
+  case 1:
+#if ((defined HAVE_SENDFILE) && (defined HAVE_SYS_SENDFILE_H))
+    rv = sendfile(dst, src, NULL, count);
+#else
+    errno = ENOSYS;
+    rv    = -1;
+#endif
+    break;
+  case 2:
+#ifdef HAVE_SPLICE
+    rv = splice(src, NULL, dst, NULL, count, SPLICE_F_MOVE | SPLICE_F_MORE);
+#else
+    errno = ENOSYS;
+    rv    = -1;
+#endif
+    break;
+  default:
+    errno = EINVAL;
+    rv    = -1;
+  }
+  return (0 <= rv)? IK_FIX(rv) : ik_errno_to_code();
+}
+
 
 /** --------------------------------------------------------------------
  ** File descriptors handling for Scheme ports: port position.
@@ -256,4 +390,711 @@ ikptr_fd_ref_non_blocking_mode (ikptr_t s_fd, ikpcb_t * pcb)
 #endif
 }
 
+
+/** --------------------------------------------------------------------
+ ** File descriptors handling for Scheme ports: io_uring read-ahead.
+ ** ----------------------------------------------------------------- */
+
+/* An "uring reader" keeps DEPTH  reads in flight on a file descriptor,
+   each  one into  its own  buffer  of BUFFER_SIZE  bytes; the  port's
+   READ!  function  copies data  from  the  oldest completed  buffer and,
+   when a buffer is fully consumed, resubmits it.  Submissions queued by
+   a call to "ikrt_uring_reader_read()" are handed to the kernel with a
+   single "io_uring_enter()" system call.
+
+   On regular files the reads are issued at increasing offsets, so DEPTH
+   buffers of read-ahead are in flight; a short read or repositioning of
+   the port discards the outstanding buffers and restarts from the new
+   offset.
+
+   On sockets and pipes ("stream" readers) the offset is meaningless and
+   concurrent reads may complete out of order, so a single buffer is used
+   and a single read is kept in flight: the kernel receives the next chunk
+   while the port consumes the current one.  Such a read consumes the
+   incoming data, so the descriptor itself no more becomes readable; the
+   io_uring file descriptor does, when a completion is available.
+
+   When the descriptor  is in non-blocking mode  and the next buffer is
+   still in flight, "ikrt_uring_reader_read()" does not wait:  it returns
+   EAGAIN and the read stays in flight.  "ikrt_uring_reader_wait_fd()"
+   returns the descriptor to wait for before retrying: the io_uring one
+   while a read is in flight, the port's one otherwise (the kernel can
+   complete reads on non-blocking sockets with EAGAIN).  Terminals are not
+   supported.
+
+   The buffers are registered with the kernel when possible ("fixed"
+   buffers);  if the  registration fails,  for  example because  of the
+   limit on locked memory, plain reads are used.
+
+   The  ring is  set up  with  raw system  calls, so  no external  library
+   is needed; when the kernel does not support io_uring the functions
+   return an ENOSYS error code and the  Scheme code falls back to plain
+   "read()". */
+
+#if ((defined HAVE_LINUX_IO_URING_H) && (defined HAVE_SYS_MMAN_H))
+#  include <linux/io_uring.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  if ((defined __NR_io_uring_setup) && (defined __NR_io_uring_enter) && (defined __NR_io_uring_register))
+#    define IK_HAVE_IO_URING	1
+#  endif
+#endif
+
+#ifdef IK_HAVE_IO_URING
+
+#define IK_URING_BUFFER_IDLE		0
+#define IK_URING_BUFFER_IN_FLIGHT	1
+#define IK_URING_BUFFER_DONE		2
+
+/* User data of cancellation requests; read requests use the buffer index. */
+#define IK_URING_CANCEL_TAG		((uint64_t)-1)
+
+typedef struct ik_uring_buffer_t {
+  int		state;
+  int		result;		/* number of bytes read or negated errno */
+  off_t		offset;		/* file offset of the read */
+  size_t	consumed;	/* number of bytes already copied out */
+} ik_uring_buffer_t;
+
+typedef struct ik_uring_reader_t {
+  int			ring_fd;
+  int			fd;
+  int			fixed;		/* true if buffers are registered */
+  int			stream;		/* true for sockets and pipes */
+  unsigned		depth;
+  size_t		buffer_size;
+  uint8_t *		memory;
+  ik_uring_buffer_t *	buffers;
+  unsigned		head;		/* index of the buffer being consumed */
+  off_t			next_offset;	/* offset of the next read to submit */
+  unsigned		in_flight;
+  unsigned		to_submit;
+  /* submission queue */
+  void *		sq_ring;
+  size_t		sq_ring_len;
+  unsigned *		sq_head;
+  unsigned *		sq_tail;
+  unsigned *		sq_mask;
+  unsigned *		sq_array;
+  struct io_uring_sqe *	sqes;
+  size_t		sqes_len;
+  /* completion queue */
+  void *		cq_ring;
+  size_t		cq_ring_len;
+  unsigned *		cq_head;
+  unsigned *		cq_tail;
+  unsigned *		cq_mask;
+  struct io_uring_cqe *	cqes;
+} ik_uring_reader_t;
+
+static int
+ik_uring_setup (unsigned entries, struct io_uring_params * params)
+{
+  return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+static int
+ik_uring_enter (int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+  return (int)syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, NULL, 0);
+}
+static int
+ik_uring_register (int ring_fd, unsigned opcode, void * arg, unsigned nr_args)
+{
+  return (int)syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args);
+}
+
+static void
+ik_uring_unmap (ik_uring_reader_t * R)
+{
+  if (R->sqes)
+    munmap(R->sqes, R->sqes_len);
+  if (R->cq_ring && (R->cq_ring != R->sq_ring))
+    munmap(R->cq_ring, R->cq_ring_len);
+  if (R->sq_ring)
+    munmap(R->sq_ring, R->sq_ring_len);
+}
+static int
+ik_uring_map (ik_uring_reader_t * R, struct io_uring_params * p)
+/* Map the  rings  of the  io_uring instance  into memory.  Return zero  on
+   success, -1 on error with "errno" set. */
+{
+  uint8_t *	ptr;
+  R->sq_ring_len = p->sq_off.array + p->sq_entries * sizeof(unsigned);
+  R->cq_ring_len = p->cq_off.cqes  + p->cq_entries * sizeof(struct io_uring_cqe);
+  if (p->features & IORING_FEAT_SINGLE_MMAP) {
+    if (R->cq_ring_len > R->sq_ring_len)
+      R->sq_ring_len = R->cq_ring_len;
+    R->cq_ring_len = R->sq_ring_len;
+  }
+  R->sq_ring = mmap(NULL, R->sq_ring_len, PROT_READ | PROT_WRITE,
+		    MAP_SHARED | MAP_POPULATE, R->ring_fd, IORING_OFF_SQ_RING);
+  if (MAP_FAILED == R->sq_ring) {
+    R->sq_ring = NULL;
+    return -1;
+  }
+  if (p->features & IORING_FEAT_SINGLE_MMAP) {
+    R->cq_ring = R->sq_ring;
+  } else {
+    R->cq_ring = mmap(NULL, R->cq_ring_len, PROT_READ | PROT_WRITE,
+		      MAP_SHARED | MAP_POPULATE, R->ring_fd, IORING_OFF_CQ_RING);
+    if (MAP_FAILED == R->cq_ring) {
+      R->cq_ring = NULL;
+      return -1;
+    }
+  }
+  R->sqes_len = p->sq_entries * sizeof(struct io_uring_sqe);
+  R->sqes     = mmap(NULL, R->sqes_len, PROT_READ | PROT_WRITE,
+		     MAP_SHARED | MAP_POPULATE, R->ring_fd, IORING_OFF_SQES);
+  if (MAP_FAILED == R->sqes) {
+    R->sqes = NULL;
+    return -1;
+  }
+  ptr		= R->sq_ring;
+  R->sq_head	= (unsigned *)(ptr + p->sq_off.head);
+  R->sq_tail	= (unsigned *)(ptr + p->sq_off.tail);
+  R->sq_mask	= (unsigned *)(ptr + p->sq_off.ring_mask);
+  R->sq_array	= (unsigned *)(ptr + p->sq_off.array);
+  ptr		= R->cq_ring;
+  R->cq_head	= (unsigned *)(ptr + p->cq_off.head);
+  R->cq_tail	= (unsigned *)(ptr + p->cq_off.tail);
+  R->cq_mask	= (unsigned *)(ptr + p->cq_off.ring_mask);
+  R->cqes	= (struct io_uring_cqe *)(ptr + p->cq_off.cqes);
+  return 0;
+}
+
+static struct io_uring_sqe *
+ik_uring_get_sqe (ik_uring_reader_t * R)
+/* Return the next free submission queue entry, zeroed.  The queue has
+   room for twice DEPTH entries, which is enough for DEPTH reads and
+   DEPTH cancellations. */
+{
+  unsigned		tail = *(R->sq_tail);
+  unsigned		idx  = tail & *(R->sq_mask);
+  struct io_uring_sqe *	sqe  = &(R->sqes[idx]);
+  memset(sqe, 0, sizeof(struct io_uring_sqe));
+  R->sq_array[idx] = idx;
+  __atomic_store_n(R->sq_tail, tail + 1, __ATOMIC_RELEASE);
+  ++(R->to_submit);
+  return sqe;
+}
+static void
+ik_uring_submit_read (ik_uring_reader_t * R, unsigned idx)
+/* Queue a read into the buffer at index IDX. */
+{
+  ik_uring_buffer_t *	B   = &(R->buffers[idx]);
+  struct io_uring_sqe *	sqe = ik_uring_get_sqe(R);
+  sqe->opcode	 = (R->fixed)? IORING_OP_READ_FIXED : IORING_OP_READV;
+  sqe->fd	 = R->fd;
+  sqe->user_data = idx;
+  if (R->fixed) {
+    sqe->addr	   = (uint64_t)(uintptr_t)(R->memory + idx * R->buffer_size);
+    sqe->len	   = (uint32_t)R->buffer_size;
+    sqe->buf_index = (uint16_t)idx;
+  } else {
+    /* The iovec array is stored right after the buffer descriptors. */
+    struct iovec *	iov = (struct iovec *)(R->buffers + R->depth);
+    sqe->addr	   = (uint64_t)(uintptr_t)(iov + idx);
+    sqe->len	   = 1;
+  }
+  B->offset	 = R->next_offset;
+  sqe->off	 = (uint64_t)R->next_offset;
+  if (! R->stream)
+    R->next_offset += (off_t)R->buffer_size;
+  B->state	= IK_URING_BUFFER_IN_FLIGHT;
+  B->result	= 0;
+  B->consumed	= 0;
+  ++(R->in_flight);
+}
+static void
+ik_uring_reap (ik_uring_reader_t * R)
+/* Consume all the available completion queue entries. */
+{
+  unsigned	head = *(R->cq_head);
+  unsigned	tail = __atomic_load_n(R->cq_tail, __ATOMIC_ACQUIRE);
+  while (head != tail) {
+    struct io_uring_cqe *	cqe = &(R->cqes[head & *(R->cq_mask)]);
+    if (IK_URING_CANCEL_TAG != cqe->user_data) {
+      ik_uring_buffer_t *	B = &(R->buffers[cqe->user_data]);
+      B->result	= cqe->res;
+      B->state	= IK_URING_BUFFER_DONE;
+      --(R->in_flight);
+    }
+    ++head;
+  }
+  __atomic_store_n(R->cq_head, head, __ATOMIC_RELEASE);
+}
+static int
+ik_uring_flush (ik_uring_reader_t * R, unsigned min_complete)
+/* Submit the queued requests and, if MIN_COMPLETE is non-zero, wait for
+   that number of completions.  Return zero or a negated errno code. */
+{
+  for (;;) {
+    int		rv;
+    errno = 0;
+    rv = ik_uring_enter(R->ring_fd, R->to_submit, min_complete,
+			(min_complete)? IORING_ENTER_GETEVENTS : 0);
+    if (0 <= rv) {
+      R->to_submit -= (unsigned)rv;
+      ik_uring_reap(R);
+      return 0;
+    } else if (EINTR != errno) {
+      return -errno;
+    }
+  }
+}
+static void
+ik_uring_drain (ik_uring_reader_t * R)
+/* Wait for all the reads in flight to complete and discard their data. */
+{
+  while (R->in_flight) {
+    if (ik_uring_flush(R, 1))
+      break;
+  }
+  for (unsigned i = 0; i < R->depth; ++i)
+    R->buffers[i].state = IK_URING_BUFFER_IDLE;
+}
+static void
+ik_uring_restart (ik_uring_reader_t * R, off_t offset)
+/* Discard the buffers and queue reads from OFFSET. */
+{
+  ik_uring_drain(R);
+  R->head	 = 0;
+  R->next_offset = offset;
+  for (unsigned i = 0; i < R->depth; ++i)
+    ik_uring_submit_read(R, i);
+}
+static void
+ik_uring_reader_free (ik_uring_reader_t * R)
+{
+  /* Cancel the pending reads, then wait, so that the kernel no more
+     references the buffers. */
+  for (unsigned i = 0; i < R->depth; ++i) {
+    if (IK_URING_BUFFER_IN_FLIGHT == R->buffers[i].state) {
+      struct io_uring_sqe *	sqe = ik_uring_get_sqe(R);
+      sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+      sqe->addr	     = i;
+      sqe->user_data = IK_URING_CANCEL_TAG;
+    }
+  }
+  ik_uring_drain(R);
+  ik_uring_unmap(R);
+  close(R->ring_fd);
+  free(R->memory);
+  free(R->buffers);
+  free(R);
+}
+
+#endif /* IK_HAVE_IO_URING */
+
+ikptr_t
+ikrt_uring_reader_open (ikptr_t s_fd, ikptr_t s_depth, ikptr_t s_buffer_size, ikpcb_t * pcb)
+/* Build a new reader  for the file descriptor S_FD, with S_DEPTH buffers
+   of S_BUFFER_SIZE bytes.  If successful return a pointer object, else
+   return a negated errno code; ENOSYS means  that io_uring is  not
+   supported, ENOTSUP that S_FD is not a regular file, socket or pipe.
+   Stream readers use a single buffer, whatever S_DEPTH is. */
+{
+#ifdef IK_HAVE_IO_URING
+  ik_uring_reader_t *		R;
+  struct io_uring_params	params;
+  struct stat			st;
+  struct iovec *		iov;
+  int				fd = IK_NUM_TO_FD(s_fd);
+  errno = 0;
+  if (-1 == fstat(fd, &st))
+    return ik_errno_to_code();
+  if (! (S_ISREG(st.st_mode) || S_ISSOCK(st.st_mode) || S_ISFIFO(st.st_mode)))
+    return IK_FIX(-ENOTSUP);
+  R = calloc(1, sizeof(ik_uring_reader_t));
+  if (NULL == R)
+    return ik_errno_to_code();
+  R->fd		 = fd;
+  R->stream	 = ! S_ISREG(st.st_mode);
+  R->depth	 = (R->stream)? 1 : (unsigned)IK_UNFIX(s_depth);
+  R->buffer_size = (size_t)IK_UNFIX(s_buffer_size);
+  if (R->stream) {
+    R->next_offset = 0;
+  } else {
+    R->next_offset = lseek(fd, 0, SEEK_CUR);
+    if (-1 == R->next_offset)
+      goto error_free_reader;
+  }
+  R->buffers = calloc(R->depth, sizeof(ik_uring_buffer_t) + sizeof(struct iovec));
+  if (NULL == R->buffers)
+    goto error_free_reader;
+  if (posix_memalign((void **)&(R->memory), (size_t)sysconf(_SC_PAGESIZE), R->depth * R->buffer_size)) {
+    R->memory = NULL;
+    errno = ENOMEM;
+    goto error_free_buffers;
+  }
+  iov = (struct iovec *)(R->buffers + R->depth);
+  for (unsigned i = 0; i < R->depth; ++i) {
+    iov[i].iov_base = R->memory + i * R->buffer_size;
+    iov[i].iov_len  = R->buffer_size;
+  }
+  memset(&params, 0, sizeof(params));
+  R->ring_fd = ik_uring_setup(2 * R->depth, &params);
+  if (-1 == R->ring_fd)
+    goto error_free_memory;
+  if (ik_uring_map(R, &params))
+    goto error_close_ring;
+  R->fixed = (0 == ik_uring_register(R->ring_fd, IORING_REGISTER_BUFFERS, iov, R->depth));
+  /* Start the read-ahead. */
+  for (unsigned i = 0; i < R->depth; ++i)
+    ik_uring_submit_read(R, i);
+  {
+    int	rv = ik_uring_flush(R, 0);
+    if (rv) {
+      /* Nothing was submitted: no request references the buffers. */
+      errno = -rv;
+      goto error_close_ring;
+    }
+  }
+  return ika_pointer_alloc(pcb, (ikuword_t)R);
+
+ error_close_ring:
+  {
+    int	code = errno;
+    ik_uring_unmap(R);
+    close(R->ring_fd);
+    errno = code;
+  }
+ error_free_memory:
+  free(R->memory);
+ error_free_buffers:
+  free(R->buffers);
+ error_free_reader:
+  {
+    int	code = errno;
+    free(R);
+    errno = code;
+  }
+  return ik_errno_to_code();
+#else
+  return IK_FIX(-ENOSYS);
+#endif
+}
+ikptr_t
+ikrt_uring_reader_read (ikptr_t s_reader, ikptr_t s_dst_bv, ikptr_t s_dst_start, ikptr_t s_count /*, ikpcb_t * pcb */)
+/* Copy  at most  S_COUNT bytes  of  read-ahead data  into the  bytevector
+   S_DST_BV, starting at index S_DST_START; if no data is available: block
+   or, if the descriptor is in non-blocking mode, return EAGAIN leaving the
+   read in flight.  Return the number of bytes copied, zero at end-of-file,
+   or a negated errno code. */
+{
+#ifdef IK_HAVE_IO_URING
+  ik_uring_reader_t *	R   = IK_POINTER_DATA_VOIDP(s_reader);
+  ik_uring_buffer_t *	B   = &(R->buffers[R->head]);
+  uint8_t *		dst = ((uint8_t *)IK_BYTEVECTOR_DATA_VOIDP(s_dst_bv)) + IK_UNFIX(s_dst_start);
+  size_t		count;
+  int			rv;
+  if (IK_URING_BUFFER_IDLE == B->state)
+    ik_uring_submit_read(R, R->head);
+  if ((IK_URING_BUFFER_IN_FLIGHT == B->state) && (O_NONBLOCK & fcntl(R->fd, F_GETFL))) {
+    rv = ik_uring_flush(R, 0);
+    if (rv)
+      return IK_FIX(rv);
+    if (IK_URING_BUFFER_IN_FLIGHT == B->state)
+      return IK_FIX(-EAGAIN);
+  }
+  while (IK_URING_BUFFER_IN_FLIGHT == B->state) {
+    rv = ik_uring_flush(R, 1);
+    if (rv)
+      return IK_FIX(rv);
+  }
+  if (0 >= B->result) {
+    /* End-of-file or error: report it once, then the next call retries
+       from the same position. */
+    rv = B->result;
+    if (R->stream) {
+      B->state = IK_URING_BUFFER_IDLE;
+    } else {
+      ik_uring_restart(R, B->offset);
+      ik_uring_flush(R, 0);
+    }
+    return IK_FIX(rv);
+  }
+  count = (size_t)B->result - B->consumed;
+  if (count > (size_t)IK_UNFIX(s_count))
+    count = (size_t)IK_UNFIX(s_count);
+  memcpy(dst, R->memory + R->head * R->buffer_size + B->consumed, count);
+  B->consumed += count;
+  if (B->consumed == (size_t)B->result) {
+    if ((! R->stream) && ((size_t)B->result < R->buffer_size)) {
+      /* Short read: the reads in flight after this one have the wrong
+	 offsets. */
+      ik_uring_restart(R, B->offset + B->result);
+    } else {
+      ik_uring_submit_read(R, R->head);
+      R->head = (R->head + 1) % R->depth;
+    }
+  }
+  ik_uring_flush(R, 0);
+  return IK_FIX(count);
+#else
+  return IK_FIX(-ENOSYS);
+#endif
+}
+ikptr_t
+ikrt_uring_reader_wait_fd (ikptr_t s_reader /*, ikpcb_t * pcb */)
+/* To be  called after "ikrt_uring_reader_read()" returned EAGAIN.  Return
+   a fixnum  representing the file descriptor to wait for readability
+   before retrying: the io_uring one if a read is in flight, else the one
+   being read. */
+{
+#ifdef IK_HAVE_IO_URING
+  ik_uring_reader_t *	R = IK_POINTER_DATA_VOIDP(s_reader);
+  ik_uring_reap(R);
+  return IK_FD_TO_NUM((R->in_flight)? R->ring_fd : R->fd);
+#else
+  return IK_FIX(-ENOSYS);
+#endif
+}
+ikptr_t
+ikrt_uring_reader_set_position (ikptr_t s_reader, ikptr_t s_position /*, ikpcb_t * pcb */)
+/* Discard  the read-ahead data  and restart  reading from  S_POSITION.
+   Return false or a negated errno code. */
+{
+#ifdef IK_HAVE_IO_URING
+  ik_uring_reader_t *	R      = IK_POINTER_DATA_VOIDP(s_reader);
+  off_t			offset = ik_integer_to_llong(s_position);
+  errno = 0;
+  if (-1 == lseek(R->fd, offset, SEEK_SET))
+    return ik_errno_to_code();
+  ik_uring_restart(R, offset);
+  ik_uring_flush(R, 0);
+  return IK_FALSE_OBJECT;
+#else
+  return IK_FIX(-ENOSYS);
+#endif
+}
+ikptr_t
+ikrt_uring_reader_close (ikptr_t s_reader /*, ikpcb_t * pcb */)
+/* Cancel the reads in flight and release the reader.  The underlying file
+   descriptor is not closed.  Return false. */
+{
+#ifdef IK_HAVE_IO_URING
+  ik_uring_reader_t *	R = IK_POINTER_DATA_VOIDP(s_reader);
+  if (R) {
+    ik_uring_reader_free(R);
+    IK_POINTER_SET_NULL(s_reader);
+  }
+#endif
+  return IK_FALSE_OBJECT;
+}
+
+
+/** --------------------------------------------------------------------
+ ** File descriptors handling for Scheme ports: memory-mapped input files.
+ ** ----------------------------------------------------------------- */
+
+/* A memory-mapped input port maps the whole file read-only;  the file
+   descriptor can be closed right after mapping.  The Scheme port copies
+   data from the mapping with "memcpy()" rather than with "read()", and
+   can hand out views of the mapping as memory blocks. */
+
+#ifdef HAVE_SYS_MMAN_H
+#  include <sys/mman.h>
+#endif
+
+ikptr_t
+ikrt_mmap_input_fd (ikptr_t s_fd, ikpcb_t * pcb)
+/* Map  the regular  file referenced by S_FD.   If successful return a pair
+   whose car is a pointer object referencing the mapping and whose cdr is
+   an exact integer representing  the file size; the pointer is NULL if
+   the file is empty.  Otherwise return a negative fixnum representing an
+   ERRNO code: EINVAL if the descriptor does not reference a regular file,
+   ENOSYS if memory mapping is not supported. */
+{
+#ifdef HAVE_SYS_MMAN_H
+  struct stat	st;
+  void *	mapping = NULL;
+  errno = 0;
+  if (0 != fstat(IK_NUM_TO_FD(s_fd), &st))
+    return ik_errno_to_code();
+  if (! S_ISREG(st.st_mode)) {
+    errno = EINVAL;
+    return ik_errno_to_code();
+  }
+  if (0 < st.st_size) {
+    if ((uintmax_t)st.st_size > (uintmax_t)SIZE_MAX) {
+      errno = EFBIG;
+      return ik_errno_to_code();
+    }
+    mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, IK_NUM_TO_FD(s_fd), 0);
+    if (MAP_FAILED == mapping)
+      return ik_errno_to_code();
+#if ((defined HAVE_MADVISE) && (defined MADV_SEQUENTIAL))
+    madvise(mapping, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+  }
+  {
+    ikptr_t	s_pair = ika_pair_alloc(pcb);
+    pcb->root0 = &s_pair;
+    {
+      IK_ASS(IK_CAR(s_pair), ika_pointer_alloc(pcb, (ikuword_t)mapping));
+      IK_SIGNAL_DIRT_IN_PAGE_OF_POINTER(pcb, IK_CAR_PTR(s_pair));
+      IK_ASS(IK_CDR(s_pair), ika_integer_from_off_t(pcb, st.st_size));
+      IK_SIGNAL_DIRT_IN_PAGE_OF_POINTER(pcb, IK_CDR_PTR(s_pair));
+    }
+    pcb->root0 = NULL;
+    return s_pair;
+  }
+#else
+  errno = ENOSYS;
+  return ik_errno_to_code();
+#endif
+}
+ikptr_t
+ikrt_mmap_input_read (ikptr_t s_mapping, ikptr_t s_offset,
+		      ikptr_t s_dst_bv, ikptr_t s_dst_start, ikptr_t s_count /*, ikpcb_t * pcb */)
+/* Copy S_COUNT octets  from the mapping, starting at S_OFFSET,  into the
+   bytevector S_DST_BV, starting at S_DST_START.  The arguments have already
+   been validated by the Scheme code. */
+{
+  uint8_t *	src = IK_POINTER_DATA_UINT8P(s_mapping) + ik_integer_to_size_t(s_offset);
+  uint8_t *	dst = IK_BYTEVECTOR_DATA_UINT8P(s_dst_bv) + IK_UNFIX(s_dst_start);
+  memcpy(dst, src, IK_UNFIX(s_count));
+  return IK_VOID_OBJECT;
+}
+ikptr_t
+ikrt_mmap_input_close (ikptr_t s_mapping, ikptr_t s_size /*, ikpcb_t * pcb */)
+/* Unmap the file and reset the pointer to NULL.  Return false. */
+{
+#ifdef HAVE_SYS_MMAN_H
+  void *	mapping = IK_POINTER_DATA_VOIDP(s_mapping);
+  if (mapping) {
+    munmap(mapping, ik_integer_to_size_t(s_size));
+    IK_POINTER_SET_NULL(s_mapping);
+  }
+#endif
+  return IK_FALSE_OBJECT;
+}
+
+
+/** --------------------------------------------------------------------
+ ** Port statistics.
+ ** ----------------------------------------------------------------- */
+
+ikptr_t
+ikrt_io_monotonic_usecs (ikpcb_t * pcb)
+/* Return an exact integer representing the number of microseconds on the
+   monotonic clock.  Used to measure the time spent blocked in device
+   operations; only differences between return values are meaningful. */
+{
+#ifdef HAVE_CLOCK_GETTIME
+  struct timespec	ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ika_integer_from_uint64(pcb, ((uint64_t)ts.tv_sec) * 1000000 + ts.tv_nsec / 1000);
+#else
+  return IK_FIX(0);
+#endif
+}
+
+
+/** --------------------------------------------------------------------
+ ** Readiness poller for coroutines.
+ ** ----------------------------------------------------------------- */
+
+/* The coroutines scheduler suspends  a coroutine whose port operation on a
+   non-blocking descriptor would block;  the descriptor is registered in an
+   epoll  instance  in one-shot  mode  and  the  coroutine is  resumed  when
+   "epoll_wait()" reports it ready.
+
+   Readiness is reported to Scheme with these bits. */
+#define IK_IO_POLLER_READ	1
+#define IK_IO_POLLER_WRITE	2
+
+ikptr_t
+ikrt_io_poller_open (void)
+/* Open an epoll instance.  Return its descriptor as fixnum or an encoded
+   errno value; ENOSYS if epoll is not available. */
+{
+#ifdef IK_HAVE_IO_POLLER
+  int	rv;
+  errno = 0;
+  rv    = epoll_create1(EPOLL_CLOEXEC);
+  return (0 <= rv)? IK_FD_TO_NUM(rv) : ik_errno_to_code();
+#else
+  return IK_FIX(-ENOSYS);
+#endif
+}
+ikptr_t
+ikrt_io_poller_arm (ikptr_t s_poller, ikptr_t s_fd, ikptr_t s_directions)
+/* Wait,  in  one-shot mode,  for the  descriptor S_FD  to become ready  for
+   S_DIRECTIONS,  a  fixnum   combination  of  IK_IO_POLLER_READ  and
+   IK_IO_POLLER_WRITE.  Return false or an encoded errno value. */
+{
+#ifdef IK_HAVE_IO_POLLER
+  struct epoll_event	event;
+  int			poller     = IK_NUM_TO_FD(s_poller);
+  int			fd         = IK_NUM_TO_FD(s_fd);
+  long			directions = IK_UNFIX(s_directions);
+  int			rv;
+  memset(&event, 0, sizeof(event));
+  event.events  = EPOLLONESHOT
+    | ((directions & IK_IO_POLLER_READ)?  EPOLLIN  : 0)
+    | ((directions & IK_IO_POLLER_WRITE)? EPOLLOUT : 0);
+  event.data.fd = fd;
+  /* Descriptors stay  registered after a one-shot event,  so we try first to
+     modify an existing registration. */
+  errno = 0;
+  rv    = epoll_ctl(poller, EPOLL_CTL_MOD, fd, &event);
+  if ((-1 == rv) && (ENOENT == errno)) {
+    errno = 0;
+    rv    = epoll_ctl(poller, EPOLL_CTL_ADD, fd, &event);
+  }
+  return (-1 != rv)? IK_FALSE_OBJECT : ik_errno_to_code();
+#else
+  return IK_FIX(-ENOSYS);
+#endif
+}
+ikptr_t
+ikrt_io_poller_forget (ikptr_t s_poller, ikptr_t s_fd)
+/* Remove the registration of S_FD, if any.  Return false. */
+{
+#ifdef IK_HAVE_IO_POLLER
+  epoll_ctl(IK_NUM_TO_FD(s_poller), EPOLL_CTL_DEL, IK_NUM_TO_FD(s_fd), NULL);
+#endif
+  return IK_FALSE_OBJECT;
+}
+ikptr_t
+ikrt_io_poller_wait (ikptr_t s_poller, ikptr_t s_ready, ikptr_t s_timeout)
+/* Wait  for  ready  descriptors  for  at most  S_TIMEOUT  milliseconds;  -1
+   means  wait  forever.   S_READY  is  a Scheme  vector  of  even  length:
+   store in it  descriptor and readiness bits, as fixnums, for every ready
+   descriptor.  Return  the number of  ready descriptors or  an encoded
+   errno value.
+
+   Hang-up and error conditions are reported as  readiness in both
+   directions: the retried operation reports them. */
+{
+#ifdef IK_HAVE_IO_POLLER
+#define IK_IO_POLLER_MAX_EVENTS		64
+  struct epoll_event	events[IK_IO_POLLER_MAX_EVENTS];
+  long			max = IK_VECTOR_LENGTH(s_ready) / 2;
+  int			rv, i;
+  if (max > IK_IO_POLLER_MAX_EVENTS)
+    max = IK_IO_POLLER_MAX_EVENTS;
+  errno = 0;
+  rv    = epoll_wait(IK_NUM_TO_FD(s_poller), events, (int)max, (int)IK_UNFIX(s_timeout));
+  if (-1 == rv)
+    return ik_errno_to_code();
+  for (i = 0; i < rv; ++i) {
+    uint32_t	flags = events[i].events;
+    long	ready = 0;
+    if (flags & (EPOLLIN  | EPOLLHUP | EPOLLERR))
+      ready |= IK_IO_POLLER_READ;
+    if (flags & (EPOLLOUT | EPOLLHUP | EPOLLERR))
+      ready |= IK_IO_POLLER_WRITE;
+    /* Fixnums need no write barrier. */
+    IK_ITEM(s_ready, 2 * i)     = IK_FD_TO_NUM(events[i].data.fd);
+    IK_ITEM(s_ready, 2 * i + 1) = IK_FIX(ready);
+  }
+  return IK_FIX(rv);
+#else
+  return IK_FIX(-ENOSYS);
+#endif
+}
+
 /* end of file */
@@ -72,6 +72,7 @@ ikarus_main (int argc, char** argv, char* boot_file)
     exit(EXIT_FAILURE);
   }
 #endif
+  ik_simd_init();
   if (sizeof(mp_limb_t) != sizeof(long int))
     ik_abort("limb size does not match");
   if (mp_bits_per_limb != (8*sizeof(long int)))
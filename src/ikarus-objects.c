@@ -246,13 +246,16 @@ ikptr_t
 ikrt_bytevector_copy (ikptr_t s_dst, ikptr_t s_dst_start,
 		      ikptr_t s_src, ikptr_t s_src_start,
 		      ikptr_t s_count)
+/* Copy S_COUNT octets  from S_SRC, starting at S_SRC_START,  to S_DST,
+   starting  at S_DST_START.   The  source and  destination ranges  can
+   overlap.  Return the void object. */
 {
   ikuword_t	src_start = IK_UNFIX(s_src_start);
   ikuword_t	dst_start = IK_UNFIX(s_dst_start);
   size_t	count     = (size_t)IK_UNFIX(s_count);
   uint8_t *	dst = IK_BYTEVECTOR_DATA_UINT8P(s_dst) + dst_start;
   uint8_t *	src = IK_BYTEVECTOR_DATA_UINT8P(s_src) + src_start;
-  memcpy(dst, src, count);
+  memmove(dst, src, count);
   return IK_VOID_OBJECT;
 }
 ikptr_t
@@ -812,7 +815,7 @@ ika_string_alloc (ikpcb_t * pcb, ikuword_t number_of_chars)
   /* Do not ask me why, but IK_ALIGN is needed here. */
   align_size = IK_ALIGN(disp_string_data + number_of_chars * sizeof(ikchar_t));
   s_str	     = ik_safe_alloc(pcb, align_size) | string_tag;
-  IK_STRING_LENGTH_FX(s_str) = IK_FIX(number_of_chars);
+  IK_STRING_HEADER(s_str) = IK_FIX(number_of_chars);
   return s_str;
 }
 ikptr_t
@@ -823,7 +826,26 @@ iku_string_alloc (ikpcb_t * pcb, ikuword_t number_of_chars)
   /* Do not ask me why, but IK_ALIGN is needed here. */
   align_size = IK_ALIGN(disp_string_data + number_of_chars * sizeof(ikchar_t));
   s_str	     = ik_unsafe_alloc(pcb, align_size) | string_tag;
-  IK_STRING_LENGTH_FX(s_str) = IK_FIX(number_of_chars);
+  IK_STRING_HEADER(s_str) = IK_FIX(number_of_chars);
+  return s_str;
+}
+
+/* ------------------------------------------------------------------ */
+
+ikptr_t
+ika_narrow_string_alloc (ikpcb_t * pcb, ikuword_t number_of_chars)
+{
+  ikptr_t s_str;
+  s_str = ik_safe_alloc(pcb, IK_NARROW_STRING_SIZE(number_of_chars)) | string_tag;
+  IK_STRING_HEADER(s_str) = IK_FIX(number_of_chars) | IK_STRING_NARROW;
+  return s_str;
+}
+ikptr_t
+iku_narrow_string_alloc (ikpcb_t * pcb, ikuword_t number_of_chars)
+{
+  ikptr_t s_str;
+  s_str = ik_unsafe_alloc(pcb, IK_NARROW_STRING_SIZE(number_of_chars)) | string_tag;
+  IK_STRING_HEADER(s_str) = IK_FIX(number_of_chars) | IK_STRING_NARROW;
   return s_str;
 }
 
@@ -852,6 +874,230 @@ iku_string_from_cstring (ikpcb_t * pcb, const char * cstr)
   return s_str;
 }
 
+/* ------------------------------------------------------------------ */
+
+uint32_t
+ik_string_code_point (ikptr_t s_str, ikuword_t idx)
+/* Return the code point of the character at index IDX in S_STR, whatever
+   the representation of S_STR. */
+{
+  if (IK_STRING_IS_NARROW(s_str)) {
+    return IK_STRING_DATA_UINT8P(s_str)[idx];
+  } else {
+    return IK_CHAR32_TO_INTEGER(IK_CHAR32(IK_STRING_WIDE_STRING(s_str), idx));
+  }
+}
+
+
+/** --------------------------------------------------------------------
+ ** Scheme string narrowing and widening.
+ ** ----------------------------------------------------------------- */
+
+/* Text whose code points all fit in one octet (ASCII, Latin-1) is stored
+   in narrow strings, one octet for every character; storing a character
+   above #\xFF into a narrow string widens it, see "ikrt_string_widen()".
+   The following functions convert between strings and bytevectors in a
+   single pass and without building a Scheme character for every element;
+   between a narrow string and a bytevector they are a "memcpy()".
+
+   The benchmark "attic/benchmarks/string-conversion-bench.ss" compares them
+   with the character by character loops they replaced. */
+
+ikptr_t
+ikrt_string_widen (ikptr_t s_str, ikpcb_t * pcb)
+/* Called by  the code compiled for  "$string-set!" when storing  a wide
+   character into the narrow string  S_STR.  Allocate a wide string with
+   the characters of S_STR and make  S_STR reference it, so that S_STR
+   keeps its  identity.  Return  the wide string.   If S_STR is  not
+   narrow: just return the wide string holding its characters. */
+{
+  ikuword_t	len;
+  ikptr_t	s_wide;
+  if (! IK_STRING_IS_NARROW(s_str)) {
+    return IK_STRING_WIDE_STRING(s_str);
+  }
+  len = IK_STRING_LENGTH(s_str);
+  pcb->root0 = &s_str;
+  {
+    s_wide = ika_string_alloc(pcb, len);
+  }
+  pcb->root0 = NULL;
+  {
+    uint8_t *	src = IK_STRING_DATA_UINT8P(s_str);
+    ikchar *	dst = IK_STRING_DATA_IKCHARP(s_wide);
+    ikuword_t	i;
+    for (i=0; i<len; ++i) {
+      dst[i] = IK_CHAR32_FROM_INTEGER(src[i]);
+    }
+  }
+  IK_REF(s_str, off_string_data) = s_wide;
+  IK_STRING_HEADER(s_str)        = IK_FIX(len) | IK_STRING_WIDENED;
+  ik_register_widened_string(pcb, s_str);
+  return s_wide;
+}
+void
+ik_register_widened_string (ikpcb_t * pcb, ikptr_t s_str)
+/* Register the widened string S_STR in the list of its generation; see
+   the documentation of the PCB's member "widened_strings". */
+{
+  int			gen   = pcb->segment_vector[IK_PAGE_INDEX(s_str)] & GEN_MASK;
+  ik_ptr_page_t *	first = pcb->widened_strings[gen];
+  if ((NULL == first) || (IK_PTR_PAGE_NUMBER_OF_GUARDIANS_SLOTS == first->count)) {
+    ik_ptr_page_t *	new_node;
+    new_node        = (ik_ptr_page_t*)ik_mmap(IK_PAGESIZE);
+    new_node->count = 0;
+    new_node->next  = first;
+    first           = new_node;
+    pcb->widened_strings[gen] = new_node;
+  }
+  first->ptr[first->count++] = s_str;
+}
+
+/* ------------------------------------------------------------------ */
+
+ikptr_t
+ikrt_string_find_code_point_above (ikptr_t s_str, ikptr_t s_limit)
+/* Return  a fixnum  representing the  index  of the  first character  in
+   S_STR whose  code point is  greater than the  fixnum S_LIMIT; if  no such
+   character exists: return false. */
+{
+  ikuword_t	len   = IK_STRING_LENGTH(s_str);
+  uint32_t	limit = (uint32_t)IK_UNFIX(s_limit);
+  ikuword_t	i;
+  if (IK_STRING_IS_NARROW(s_str)) {
+    uint8_t *	data = IK_STRING_DATA_UINT8P(s_str);
+    if (limit < 255) {
+      for (i=0; i<len; ++i) {
+	if (data[i] > limit) {
+	  return IK_FIX(i);
+	}
+      }
+    }
+  } else {
+    ikchar *	data = IK_STRING_DATA_IKCHARP(IK_STRING_WIDE_STRING(s_str));
+    for (i=0; i<len; ++i) {
+      if (IK_CHAR32_TO_INTEGER(data[i]) > limit) {
+	return IK_FIX(i);
+      }
+    }
+  }
+  return IK_FALSE;
+}
+ikptr_t
+ikrt_bytevector_find_octet_above (ikptr_t s_bv, ikptr_t s_limit)
+/* Return a fixnum representing the index of the first octet in S_BV which
+   is greater than the fixnum S_LIMIT; if no such octet exists: return
+   false. */
+{
+  ikuword_t	len   = IK_BYTEVECTOR_LENGTH(s_bv);
+  uint8_t *	data  = IK_BYTEVECTOR_DATA_UINT8P(s_bv);
+  ikuword_t	limit = IK_UNFIX(s_limit);
+  ikuword_t	i;
+  if (limit < 255) {
+    for (i=0; i<len; ++i) {
+      if (data[i] > limit) {
+	return IK_FIX(i);
+      }
+    }
+  }
+  return IK_FALSE;
+}
+ikptr_t
+ikrt_string_narrow (ikptr_t s_str, ikpcb_t * pcb)
+/* Build and return a new bytevector  holding the code points of S_STR
+   truncated to one octet.  The caller must have already validated the
+   code points, for example with "ikrt_string_find_code_point_above()". */
+{
+  ikuword_t	len = IK_STRING_LENGTH(s_str);
+  ikptr_t	s_bv;
+  pcb->root0 = &s_str;
+  {
+    s_bv = ika_bytevector_alloc(pcb, len);
+  }
+  pcb->root0 = NULL;
+  if (IK_STRING_IS_NARROW(s_str)) {
+    memcpy(IK_BYTEVECTOR_DATA_UINT8P(s_bv), IK_STRING_DATA_UINT8P(s_str), len);
+  } else {
+    ikchar *	src = IK_STRING_DATA_IKCHARP(IK_STRING_WIDE_STRING(s_str));
+    uint8_t *	dst = IK_BYTEVECTOR_DATA_UINT8P(s_bv);
+    ikuword_t	i;
+    for (i=0; i<len; ++i) {
+      dst[i] = (uint8_t)IK_CHAR32_TO_INTEGER(src[i]);
+    }
+  }
+  return s_bv;
+}
+ikptr_t
+ikrt_bytevector_widen (ikptr_t s_bv, ikpcb_t * pcb)
+/* Build and return  a new narrow string holding the octets of S_BV as
+   code points. */
+{
+  ikuword_t	len = IK_BYTEVECTOR_LENGTH(s_bv);
+  ikptr_t	s_str;
+  pcb->root0 = &s_bv;
+  {
+    s_str = ika_narrow_string_alloc(pcb, len);
+  }
+  pcb->root0 = NULL;
+  memcpy(IK_STRING_DATA_UINT8P(s_str), IK_BYTEVECTOR_DATA_UINT8P(s_bv), len);
+  return s_str;
+}
+ikptr_t
+ikrt_bytevector_ascii_span (ikptr_t s_bv, ikptr_t s_start, ikptr_t s_end, ikptr_t s_stop_set)
+/* Return a fixnum representing the number of octets in S_BV, from index
+   S_START included to S_END excluded, before the first octet that is not
+   ASCII or that is selected by S_STOP_SET.  S_STOP_SET is a fixnum bit
+   mask: if bit N is set, the octet N (with N < 32) ends the span.
+
+   Octets are  tested a word  at a  time: a word  whose octets are  all in
+   the range [32, 127] is skipped as a whole, otherwise its octets are
+   tested one by one. */
+{
+  uint8_t *	data  = IK_BYTEVECTOR_DATA_UINT8P(s_bv);
+  ikuword_t	start = IK_UNFIX(s_start);
+  ikuword_t	end   = IK_UNFIX(s_end);
+  uint32_t	stop  = (uint32_t)IK_UNFIX(s_stop_set);
+  ikuword_t	i     = start;
+  while (i < end) {
+    ikuword_t	limit;
+    for (; i + sizeof(uint64_t) <= end; i += sizeof(uint64_t)) {
+      uint64_t	word;
+      memcpy(&word, data + i, sizeof(uint64_t));
+      if ((word | (word - UINT64_C(0x2020202020202020))) & UINT64_C(0x8080808080808080)) {
+	break;
+      }
+    }
+    limit = (i + sizeof(uint64_t) <= end)? (i + sizeof(uint64_t)) : end;
+    for (; i < limit; ++i) {
+      uint8_t	octet = data[i];
+      if ((0x7F < octet) || ((octet < 32) && (stop & (UINT32_C(1) << octet)))) {
+	return IK_FIX(i - start);
+      }
+    }
+  }
+  return IK_FIX(end - start);
+}
+ikptr_t
+ikrt_bytevector_widen_into (ikptr_t s_bv, ikptr_t s_bv_start,
+			    ikptr_t s_str, ikptr_t s_str_start, ikptr_t s_count)
+/* Store S_COUNT octets of S_BV, starting at index S_BV_START, as code
+   points into S_STR, starting at index S_STR_START.  The caller must have
+   validated the ranges.  Return the void object. */
+{
+  uint8_t *	src   = IK_BYTEVECTOR_DATA_UINT8P(s_bv) + IK_UNFIX(s_bv_start);
+  ikuword_t	count = IK_UNFIX(s_count);
+  if (IK_STRING_IS_NARROW(s_str)) {
+    memcpy(IK_STRING_DATA_UINT8P(s_str) + IK_UNFIX(s_str_start), src, count);
+  } else {
+    ikchar *	dst = IK_STRING_DATA_IKCHARP(IK_STRING_WIDE_STRING(s_str)) + IK_UNFIX(s_str_start);
+    ikuword_t	i;
+    for (i=0; i<count; ++i) {
+      dst[i] = IK_CHAR32_FROM_INTEGER(src[i]);
+    }
+  }
+  return IK_VOID;
+}
+
 
 /** --------------------------------------------------------------------
  ** Symbols.
@@ -1669,8 +1915,24 @@ ikrt_general_copy (ikptr_t s_dst, ikptr_t s_dst_start,
 		   ikptr_t s_count, ikpcb_t * pcb)
 /* General binary  data copy function.   It copies data from  raw memory
    block  or Scheme  bytevector Scheme  string  to raw  memory block  or
-   Scheme bytevector or Scheme string. */
+   Scheme bytevector or Scheme string.  The data of a string is its array
+   of 32-bit characters: narrow strings are widened first, and strings are
+   replaced by the wide strings holding their characters. */
 {
+  if (IK_IS_STRING(s_src)) {
+    pcb->root1 = &s_dst;
+    {
+      s_src = ikrt_string_widen(s_src, pcb);
+    }
+    pcb->root1 = NULL;
+  }
+  if (IK_IS_STRING(s_dst)) {
+    pcb->root1 = &s_src;
+    {
+      s_dst = ikrt_string_widen(s_dst, pcb);
+    }
+    pcb->root1 = NULL;
+  }
   ikuword_t	src_start = IK_UNFIX(s_src_start);
   ikuword_t	dst_start = IK_UNFIX(s_dst_start);
   size_t	count     = (size_t)IK_UNFIX(s_count);
@@ -1682,7 +1944,7 @@ ikrt_general_copy (ikptr_t s_dst, ikptr_t s_dst_start,
     src = IK_POINTER_DATA_UINT8P(s_src) + src_start;
   } else if (IK_IS_STRING(s_src)) {
     src_start <<= 2; /* multiply by 4 */
-    src = IK_STRING_DATA_VOIDP(s_src);
+    src = (uint8_t*)IK_STRING_DATA_VOIDP(s_src) + src_start;
   } else
     ik_abort("%s: invalid src value, %lu", __func__, (ik_ulong)s_src);
 
@@ -1692,7 +1954,7 @@ ikrt_general_copy (ikptr_t s_dst, ikptr_t s_dst_start,
     dst = IK_POINTER_DATA_UINT8P(s_dst) + dst_start;
   } else if (IK_IS_STRING(s_dst)) {
     dst_start <<= 2; /* multiply by 4 */
-    dst = IK_STRING_DATA_VOIDP(s_dst);
+    dst = (uint8_t*)IK_STRING_DATA_VOIDP(s_dst) + dst_start;
   } else
     ik_abort("%s: invalid dst value, %lu", __func__, (ik_ulong)s_dst);
 
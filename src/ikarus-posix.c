@@ -1641,6 +1641,16 @@ ikrt_posix_writev (ikptr_t s_fd, ikptr_t s_buffers, ikpcb_t * pcb)
 
 /* ------------------------------------------------------------------ */
 
+#ifdef HAVE_SELECT
+static int
+ik_fd_fits_fd_set (int fd)
+/* Return true if  FD can be stored in  a "fd_set"; "FD_SET()" applied to  a descriptor
+   greater than or equal to FD_SETSIZE writes past the end of the set. */
+{
+  return ((0 <= fd) && (fd < FD_SETSIZE));
+}
+#endif
+
 ikptr_t
 ikrt_posix_select (ikptr_t nfds_fx,
 		   ikptr_t read_fds_ell, ikptr_t write_fds_ell, ikptr_t except_fds_ell,
@@ -1663,6 +1673,10 @@ ikrt_posix_select (ikptr_t nfds_fx,
   FD_ZERO(&read_fds);
   for (L=read_fds_ell; pair_tag == IK_TAGOF(L); L = IK_REF(L, off_cdr)) {
     fd = IK_UNFIX(IK_REF(L, off_car));
+    if (! ik_fd_fits_fd_set(fd)) {
+      errno = EINVAL;
+      return ik_errno_to_code();
+    }
     if (nfds < fd)
       nfds = fd;
     FD_SET(fd, &read_fds);
@@ -1671,6 +1685,10 @@ ikrt_posix_select (ikptr_t nfds_fx,
   FD_ZERO(&write_fds);
   for (L=write_fds_ell; pair_tag == IK_TAGOF(L); L = IK_REF(L, off_cdr)) {
     fd = IK_UNFIX(IK_REF(L, off_car));
+    if (! ik_fd_fits_fd_set(fd)) {
+      errno = EINVAL;
+      return ik_errno_to_code();
+    }
     if (nfds < fd)
       nfds = fd;
     FD_SET(fd, &write_fds);
@@ -1679,6 +1697,10 @@ ikrt_posix_select (ikptr_t nfds_fx,
   FD_ZERO(&except_fds);
   for (L=except_fds_ell; pair_tag == IK_TAGOF(L); L = IK_REF(L, off_cdr)) {
     fd = IK_UNFIX(IK_REF(L, off_car));
+    if (! ik_fd_fits_fd_set(fd)) {
+      errno = EINVAL;
+      return ik_errno_to_code();
+    }
     if (nfds < fd)
       nfds = fd;
     FD_SET(fd, &except_fds);
@@ -1765,6 +1787,10 @@ ikrt_posix_select_fd (ikptr_t s_fd, ikptr_t sec, ikptr_t usec, ikpcb_t * pcb)
   FD_ZERO(&write_fds);
   FD_ZERO(&except_fds);
   fd = IK_NUM_TO_FD(s_fd);
+  if (! ik_fd_fits_fd_set(fd)) {
+    errno = EINVAL;
+    return ik_errno_to_code();
+  }
   FD_SET(fd, &read_fds);
   FD_SET(fd, &write_fds);
   FD_SET(fd, &except_fds);
@@ -1812,6 +1838,10 @@ ikrt_posix_select_is_readable (ikptr_t s_fd, ikptr_t s_sec, ikptr_t s_usec, ikpc
   FD_ZERO(&write_fds);
   FD_ZERO(&except_fds);
   fd = IK_NUM_TO_FD(s_fd);
+  if (! ik_fd_fits_fd_set(fd)) {
+    errno = EINVAL;
+    return ik_errno_to_code();
+  }
   FD_SET(fd, &read_fds);
   timeout.tv_sec  = IK_UNFIX(s_sec);
   timeout.tv_usec = IK_UNFIX(s_usec);
@@ -1849,6 +1879,10 @@ ikrt_posix_select_is_writable (ikptr_t s_fd, ikptr_t s_sec, ikptr_t s_usec, ikpc
   FD_ZERO(&write_fds);
   FD_ZERO(&except_fds);
   fd = IK_NUM_TO_FD(s_fd);
+  if (! ik_fd_fits_fd_set(fd)) {
+    errno = EINVAL;
+    return ik_errno_to_code();
+  }
   FD_SET(fd, &write_fds);
   timeout.tv_sec  = IK_UNFIX(s_sec);
   timeout.tv_usec = IK_UNFIX(s_usec);
@@ -1887,6 +1921,10 @@ ikrt_posix_select_is_exceptional (ikptr_t s_fd, ikptr_t s_sec, ikptr_t s_usec, i
   FD_ZERO(&write_fds);
   FD_ZERO(&except_fds);
   fd = IK_NUM_TO_FD(s_fd);
+  if (! ik_fd_fits_fd_set(fd)) {
+    errno = EINVAL;
+    return ik_errno_to_code();
+  }
   FD_SET(fd, &except_fds);
   timeout.tv_sec  = IK_UNFIX(s_sec);
   timeout.tv_usec = IK_UNFIX(s_usec);
@@ -3710,6 +3748,43 @@ ikrt_posix_accept (ikptr_t s_sock, ikpcb_t * pcb)
 #endif
 }
 ikptr_t
+ikrt_posix_accept4 (ikptr_t s_sock, ikptr_t s_flags, ikpcb_t * pcb)
+/* Like "ikrt_posix_accept()" but apply the flags S_FLAGS, a fixnum
+   combination of SOCK_NONBLOCK and SOCK_CLOEXEC, to the new socket without
+   further system calls. */
+{
+#ifdef HAVE_ACCEPT4
+#undef SIZE
+#define SIZE		512
+  uint8_t		bytes[SIZE];
+  struct sockaddr *	addr = (struct sockaddr *)bytes;
+  socklen_t		addr_len = SIZE;
+  int			rv;
+  errno	   = 0;
+  rv	   = accept4(IK_NUM_TO_FD(s_sock), addr, &addr_len, IK_UNFIX(s_flags));
+  if (0 <= rv) {
+    ikptr_t	s_pair;
+    ikptr_t	s_addr;
+    void *	addr_data;
+    s_pair     = ika_pair_alloc(pcb);
+    pcb->root0 = &s_pair;
+    {
+      s_addr	 = ika_bytevector_alloc(pcb, addr_len);
+      addr_data	 = IK_BYTEVECTOR_DATA_VOIDP(s_addr);
+      memcpy(addr_data, addr, addr_len);
+      IK_CAR(s_pair) = IK_FIX(rv);
+      IK_CDR(s_pair) = s_addr;
+      IK_SIGNAL_DIRT_IN_PAGE_OF_POINTER(pcb, IK_CDR_PTR(s_pair));
+    }
+    pcb->root0 = NULL;
+    return s_pair;
+  } else
+    return ik_errno_to_code();
+#else
+  feature_failure(__func__);
+#endif
+}
+ikptr_t
 ikrt_posix_bind (ikptr_t s_sock, ikptr_t s_socks_addr)
 {
 #ifdef HAVE_BIND
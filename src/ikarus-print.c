@@ -152,13 +152,11 @@ print_object (FILE* fh, ikptr_t x, int nested_level)
       }
     } else if (first_word == symbol_tag) {
       ikptr_t str   = IK_REF(x, off_symbol_record_string);
-      ikptr_t fxlen = IK_REF(str, off_string_length);
-      int   len   = IK_UNFIX(fxlen);
-      int * data  = (int*)(str + off_string_data);
+      int   len   = IK_STRING_LENGTH(str);
       int   i;
       fprintf(fh, "symbol=");
       for (i=0; i<len; i++) {
-        char c = (data[i]) >> char_shift;
+        char c = ik_string_code_point(str, i);
         fprintf(fh, "%c", c);
       }
     } else if (IK_TAGOF(first_word) == rtd_tag) {
@@ -202,13 +200,11 @@ print_object (FILE* fh, ikptr_t x, int nested_level)
     fprintf(fh, ")");
   }
   else if (IK_TAGOF(x) == string_tag) {
-    ikptr_t fxlen = IK_REF(x, off_string_length);
-    int   len   = IK_UNFIX(fxlen);
-    int * data  = (int*)(x + off_string_data);
+    int   len   = IK_STRING_LENGTH(x);
     int   i;
     fprintf(fh, "string=\"");
     for(i=0; i<len; i++) {
-      char c = (data[i]) >> char_shift;
+      char c = ik_string_code_point(x, i);
       if ((c == '\\') || (c == '"')) {
         fprintf(fh, "\\");
       }
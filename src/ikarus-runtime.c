@@ -708,6 +708,12 @@ ik_delete_pcb (ikpcb_t* pcb)
         ik_munmap((ikptr_t)p, IK_PAGESIZE);
 	p = next;
       }
+      p = pcb->widened_strings[i];
+      while (p) {
+        ik_ptr_page_t* next = p->next;
+        ik_munmap((ikptr_t)p, IK_PAGESIZE);
+	p = next;
+      }
     }
   }
   ikptr_t	base = pcb->memory_base;
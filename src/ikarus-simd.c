@@ -0,0 +1,382 @@
+/*
+  Part of: Vicare
+  Contents: bulk operations on bytevectors, vectors and strings
+  Date: Mon Oct 19, 2026
+
+  Abstract
+
+	Kernels  for copying,  comparing,  filling, searching  and summing
+	blocks of memory.  Where the C library already provides an optimised
+	routine ("memmove()", "memcmp()", "memset()") we use it: it selects
+	the best  implementation for the  running CPU by itself.   For the
+	other operations we  provide SSE2 and AVX2 versions  on x86 hosts,
+	selected  at start  up by  "ik_simd_init()" using  the CPUID probes
+	in "cpu_has_sse2.S", and a portable version for the other hosts.
+
+  Copyright (C) 2026 Marco Maggi <marco.maggi-ipsu@poste.it>
+
+  This program is  free software: you can redistribute	it and/or modify
+  it under the	terms of the GNU General Public	 License as published by
+  the Free Software Foundation, either	version 3 of the License, or (at
+  your option) any later version.
+
+  This program	is distributed in the  hope that it will  be useful, but
+  WITHOUT   ANY	 WARRANTY;   without  even   the  implied   warranty  of
+  MERCHANTABILITY  or FITNESS  FOR A  PARTICULAR PURPOSE.   See	 the GNU
+  General Public License for more details.
+
+  You  should have received  a copy  of the  GNU General  Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/** --------------------------------------------------------------------
+ ** Headers.
+ ** ----------------------------------------------------------------- */
+
+#include "internals.h"
+
+#if ((defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__))
+#  define IK_SIMD_X86		1
+#  include <immintrin.h>
+#  define IK_TARGET_SSE2	__attribute__((target("sse2")))
+#  define IK_TARGET_AVX2	__attribute__((target("avx2")))
+extern int cpu_has_sse2 (void);
+extern int cpu_has_avx2 (void);
+#else
+#  define IK_SIMD_X86		0
+#endif
+
+
+/** --------------------------------------------------------------------
+ ** Portable kernels.
+ ** ----------------------------------------------------------------- */
+
+static ikuword_t
+find_octet_portable (const uint8_t * data, ikuword_t len, uint8_t octet)
+/* Return the index of the first  OCTET in the LEN octets at DATA; if no
+   such octet exists: return LEN. */
+{
+  const uint8_t *	p = memchr(data, octet, len);
+  return (p)? (ikuword_t)(p - data) : len;
+}
+static uint64_t
+sum_u8_portable (const uint8_t * data, ikuword_t len)
+{
+  uint64_t	sum = 0;
+  ikuword_t	i;
+  for (i=0; i<len; ++i) {
+    sum += data[i];
+  }
+  return sum;
+}
+static uint64_t
+sum_u32_portable (const uint8_t * data, ikuword_t count)
+/* Return the sum of the COUNT native 32-bit words at DATA. */
+{
+  uint64_t	sum = 0;
+  ikuword_t	i;
+  for (i=0; i<count; ++i) {
+    uint32_t	word;
+    memcpy(&word, data + i * sizeof(uint32_t), sizeof(uint32_t));
+    sum += word;
+  }
+  return sum;
+}
+static void
+fill_words_portable (ikptr_t * data, ikuword_t count, ikptr_t word)
+{
+  ikuword_t	i;
+  for (i=0; i<count; ++i) {
+    data[i] = word;
+  }
+}
+
+
+/** --------------------------------------------------------------------
+ ** SSE2 kernels.
+ ** ----------------------------------------------------------------- */
+
+#if (IK_SIMD_X86)
+
+IK_TARGET_SSE2 static ikuword_t
+find_octet_sse2 (const uint8_t * data, ikuword_t len, uint8_t octet)
+{
+  __m128i	needle = _mm_set1_epi8((char)octet);
+  ikuword_t	i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m128i	chunk = _mm_loadu_si128((const __m128i *)(data + i));
+    int		mask  = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+    if (mask) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  for (; i < len; ++i) {
+    if (octet == data[i]) {
+      return i;
+    }
+  }
+  return len;
+}
+IK_TARGET_SSE2 static uint64_t
+sum_u8_sse2 (const uint8_t * data, ikuword_t len)
+/* PSADBW against zero adds groups of 8 octets into 64-bit lanes. */
+{
+  __m128i	zero = _mm_setzero_si128();
+  __m128i	acc  = _mm_setzero_si128();
+  uint64_t	lanes[2];
+  ikuword_t	i = 0;
+  for (; i + 16 <= len; i += 16) {
+    __m128i	chunk = _mm_loadu_si128((const __m128i *)(data + i));
+    acc = _mm_add_epi64(acc, _mm_sad_epu8(chunk, zero));
+  }
+  _mm_storeu_si128((__m128i *)lanes, acc);
+  return lanes[0] + lanes[1] + sum_u8_portable(data + i, len - i);
+}
+IK_TARGET_SSE2 static uint64_t
+sum_u32_sse2 (const uint8_t * data, ikuword_t count)
+/* Zero-extend the 32-bit words to 64-bit lanes and accumulate them. */
+{
+  __m128i	zero = _mm_setzero_si128();
+  __m128i	acc  = _mm_setzero_si128();
+  uint64_t	lanes[2];
+  ikuword_t	i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i	chunk = _mm_loadu_si128((const __m128i *)(data + i * sizeof(uint32_t)));
+    acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(chunk, zero));
+    acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(chunk, zero));
+  }
+  _mm_storeu_si128((__m128i *)lanes, acc);
+  return lanes[0] + lanes[1] + sum_u32_portable(data + i * sizeof(uint32_t), count - i);
+}
+IK_TARGET_SSE2 static void
+fill_words_sse2 (ikptr_t * data, ikuword_t count, ikptr_t word)
+{
+#define WORDS_PER_STORE		(sizeof(__m128i) / sizeof(ikptr_t))
+  __m128i	pattern = (4 == sizeof(ikptr_t))?
+    _mm_set1_epi32((int)word) : _mm_set1_epi64x((long long)word);
+  ikuword_t	i = 0;
+  for (; i + WORDS_PER_STORE <= count; i += WORDS_PER_STORE) {
+    _mm_storeu_si128((__m128i *)(data + i), pattern);
+  }
+  fill_words_portable(data + i, count - i, word);
+#undef WORDS_PER_STORE
+}
+
+
+/** --------------------------------------------------------------------
+ ** AVX2 kernels.
+ ** ----------------------------------------------------------------- */
+
+IK_TARGET_AVX2 static ikuword_t
+find_octet_avx2 (const uint8_t * data, ikuword_t len, uint8_t octet)
+{
+  __m256i	needle = _mm256_set1_epi8((char)octet);
+  ikuword_t	i = 0;
+  for (; i + 32 <= len; i += 32) {
+    __m256i	chunk = _mm256_loadu_si256((const __m256i *)(data + i));
+    unsigned	mask  = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle));
+    if (mask) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return i + find_octet_sse2(data + i, len - i, octet);
+}
+IK_TARGET_AVX2 static uint64_t
+sum_u8_avx2 (const uint8_t * data, ikuword_t len)
+{
+  __m256i	zero = _mm256_setzero_si256();
+  __m256i	acc  = _mm256_setzero_si256();
+  uint64_t	lanes[4];
+  ikuword_t	i = 0;
+  for (; i + 32 <= len; i += 32) {
+    __m256i	chunk = _mm256_loadu_si256((const __m256i *)(data + i));
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(chunk, zero));
+  }
+  _mm256_storeu_si256((__m256i *)lanes, acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_u8_sse2(data + i, len - i);
+}
+IK_TARGET_AVX2 static uint64_t
+sum_u32_avx2 (const uint8_t * data, ikuword_t count)
+{
+  __m256i	zero = _mm256_setzero_si256();
+  __m256i	acc  = _mm256_setzero_si256();
+  uint64_t	lanes[4];
+  ikuword_t	i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i	chunk = _mm256_loadu_si256((const __m256i *)(data + i * sizeof(uint32_t)));
+    acc = _mm256_add_epi64(acc, _mm256_unpacklo_epi32(chunk, zero));
+    acc = _mm256_add_epi64(acc, _mm256_unpackhi_epi32(chunk, zero));
+  }
+  _mm256_storeu_si256((__m256i *)lanes, acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+    sum_u32_sse2(data + i * sizeof(uint32_t), count - i);
+}
+IK_TARGET_AVX2 static void
+fill_words_avx2 (ikptr_t * data, ikuword_t count, ikptr_t word)
+{
+#define WORDS_PER_STORE		(sizeof(__m256i) / sizeof(ikptr_t))
+  __m256i	pattern = (4 == sizeof(ikptr_t))?
+    _mm256_set1_epi32((int)word) : _mm256_set1_epi64x((long long)word);
+  ikuword_t	i = 0;
+  for (; i + WORDS_PER_STORE <= count; i += WORDS_PER_STORE) {
+    _mm256_storeu_si256((__m256i *)(data + i), pattern);
+  }
+  fill_words_portable(data + i, count - i, word);
+#undef WORDS_PER_STORE
+}
+
+#endif /* IK_SIMD_X86 */
+
+
+/** --------------------------------------------------------------------
+ ** Runtime dispatch.
+ ** ----------------------------------------------------------------- */
+
+static ikuword_t (*find_octet) (const uint8_t * data, ikuword_t len, uint8_t octet)	= find_octet_portable;
+static uint64_t  (*sum_u8)     (const uint8_t * data, ikuword_t len)			= sum_u8_portable;
+static uint64_t  (*sum_u32)    (const uint8_t * data, ikuword_t count)			= sum_u32_portable;
+static void      (*fill_words) (ikptr_t * data, ikuword_t count, ikptr_t word)		= fill_words_portable;
+
+void
+ik_simd_init (void)
+/* Select the kernels for the running CPU.  It must be called once at
+   start up, before loading the boot file. */
+{
+#if (IK_SIMD_X86)
+  if (cpu_has_avx2()) {
+    find_octet	= find_octet_avx2;
+    sum_u8	= sum_u8_avx2;
+    sum_u32	= sum_u32_avx2;
+    fill_words	= fill_words_avx2;
+  } else if (cpu_has_sse2()) {
+    find_octet	= find_octet_sse2;
+    sum_u8	= sum_u8_sse2;
+    sum_u32	= sum_u32_sse2;
+    fill_words	= fill_words_sse2;
+  }
+#endif
+}
+
+
+/** --------------------------------------------------------------------
+ ** Bytevectors.
+ ** ----------------------------------------------------------------- */
+
+/* The  following functions  do not  validate their  arguments: the
+   callers in "ikarus.bytevectors.sls" have already checked the types,
+   the indexes and the ranges. */
+
+ikptr_t
+ikrt_bytevector_equal (ikptr_t s_bv1, ikptr_t s_bv2)
+/* Return true if the bytevectors S_BV1 and S_BV2, which must have the
+   same length, hold the same octets; otherwise return false. */
+{
+  return IK_BOOLEAN_FROM_INT(0 == memcmp(IK_BYTEVECTOR_DATA_VOIDP(s_bv1),
+					 IK_BYTEVECTOR_DATA_VOIDP(s_bv2),
+					 IK_BYTEVECTOR_LENGTH(s_bv1)));
+}
+ikptr_t
+ikrt_bytevector_fill (ikptr_t s_bv, ikptr_t s_start, ikptr_t s_end, ikptr_t s_fill)
+/* Store the fixnum S_FILL, in the range [-128, 255], in the octets of
+   S_BV from S_START included to S_END excluded.  Return the void object. */
+{
+  ikuword_t	start = IK_UNFIX(s_start);
+  memset(IK_BYTEVECTOR_DATA_UINT8P(s_bv) + start,
+	 (uint8_t)IK_UNFIX(s_fill), IK_UNFIX(s_end) - start);
+  return IK_VOID;
+}
+ikptr_t
+ikrt_bytevector_index_u8 (ikptr_t s_bv, ikptr_t s_octet, ikptr_t s_start, ikptr_t s_end)
+/* Return a fixnum  representing the index of the first  octet in S_BV,
+   from  S_START  included  to  S_END  excluded,  equal  to  the  fixnum
+   S_OCTET; if no such octet exists: return false. */
+{
+  ikuword_t	start = IK_UNFIX(s_start);
+  ikuword_t	len   = IK_UNFIX(s_end) - start;
+  ikuword_t	i     = find_octet(IK_BYTEVECTOR_DATA_UINT8P(s_bv) + start, len,
+				   (uint8_t)IK_UNFIX(s_octet));
+  return (i < len)? IK_FIX(start + i) : IK_FALSE;
+}
+ikptr_t
+ikrt_bytevector_u8_sum (ikptr_t s_bv, ikptr_t s_start, ikptr_t s_end, ikpcb_t * pcb)
+/* Return an exact integer representing the sum of the octets of S_BV,
+   from S_START included to S_END excluded. */
+{
+  ikuword_t	start = IK_UNFIX(s_start);
+  return ika_integer_from_uint64(pcb, sum_u8(IK_BYTEVECTOR_DATA_UINT8P(s_bv) + start,
+					     IK_UNFIX(s_end) - start));
+}
+ikptr_t
+ikrt_bytevector_u32_native_sum (ikptr_t s_bv, ikptr_t s_start, ikptr_t s_end, ikpcb_t * pcb)
+/* Return an exact  integer representing the sum of  the unsigned 32-bit
+   words  in native  endianness  of  S_BV, from  S_START  included to
+   S_END excluded.  The indexes  are in octets; their  difference must
+   be a multiple of 4. */
+{
+  ikuword_t	start = IK_UNFIX(s_start);
+  return ika_integer_from_uint64(pcb, sum_u32(IK_BYTEVECTOR_DATA_UINT8P(s_bv) + start,
+					      (IK_UNFIX(s_end) - start) / sizeof(uint32_t)));
+}
+
+
+/** --------------------------------------------------------------------
+ ** Vectors and strings.
+ ** ----------------------------------------------------------------- */
+
+ikptr_t
+ikrt_vector_fill (ikptr_t s_vec, ikptr_t s_start, ikptr_t s_end, ikptr_t s_fill, ikpcb_t * pcb)
+/* Store S_FILL in the slots of S_VEC from S_START included to S_END
+   excluded.  Return the void object.
+
+   Storing a  reference into  a vector is  a mutation the  garbage
+   collector must know about: unless  S_FILL is a fixnum, we signal the
+   dirt in every page spanned by the range, like "$vector-set!" does for
+   a single slot. */
+{
+  ikuword_t	start = IK_UNFIX(s_start);
+  ikuword_t	end   = IK_UNFIX(s_end);
+  if (start < end) {
+    fill_words(IK_ITEM_PTR(s_vec, start), end - start, s_fill);
+    if (! IK_IS_FIXNUM(s_fill)) {
+      ikuword_t	first = IK_PAGE_INDEX(IK_ITEM_PTR(s_vec, start));
+      ikuword_t	last  = IK_PAGE_INDEX(IK_ITEM_PTR(s_vec, end - 1));
+      ikuword_t	page;
+      for (page = first; page <= last; ++page) {
+	((uint32_t *)(pcb->dirty_vector))[page] = IK_DIRTY_WORD;
+      }
+    }
+  }
+  return IK_VOID;
+}
+ikptr_t
+ikrt_string_equal (ikptr_t s_str1, ikptr_t s_str2)
+/* Return true if the strings S_STR1 and S_STR2, which must have the
+   same length, hold the same characters; otherwise return false.  The
+   strings may have different representations. */
+{
+  ikuword_t	len = IK_STRING_LENGTH(s_str1);
+  if (IK_STRING_IS_NARROW(s_str1) && IK_STRING_IS_NARROW(s_str2)) {
+    return IK_BOOLEAN_FROM_INT(0 == memcmp(IK_STRING_DATA_UINT8P(s_str1),
+					   IK_STRING_DATA_UINT8P(s_str2),
+					   len));
+  } else if (IK_STRING_IS_NARROW(s_str1) || IK_STRING_IS_NARROW(s_str2)) {
+    ikptr_t	s_narrow = IK_STRING_IS_NARROW(s_str1)? s_str1 : s_str2;
+    ikptr_t	s_wide   = IK_STRING_WIDE_STRING(IK_STRING_IS_NARROW(s_str1)? s_str2 : s_str1);
+    uint8_t *	narrow   = IK_STRING_DATA_UINT8P(s_narrow);
+    ikchar *	wide     = IK_STRING_DATA_IKCHARP(s_wide);
+    ikuword_t	i;
+    for (i=0; i<len; ++i) {
+      if (IK_CHAR32_TO_INTEGER(wide[i]) != narrow[i]) {
+	return IK_FALSE;
+      }
+    }
+    return IK_TRUE;
+  } else {
+    return IK_BOOLEAN_FROM_INT(0 == memcmp(IK_STRING_DATA_VOIDP(IK_STRING_WIDE_STRING(s_str1)),
+					   IK_STRING_DATA_VOIDP(IK_STRING_WIDE_STRING(s_str2)),
+					   len * sizeof(ikchar)));
+  }
+}
+
+/* end of file */
@@ -63,14 +63,26 @@ ikrt_get_symbol_table (ikpcb_t* pcb)
 
 static int
 strings_eqp (ikptr_t s_str1, ikptr_t s_str2)
+/* Compare the characters of two strings, whatever their representation. */
 {
-  ikptr_t	s_len1 = IK_REF(s_str1, off_string_length);
-  if (s_len1 == IK_STRING_LENGTH_FX(s_str2)) {
-    return (0 == memcmp(IK_STRING_DATA_VOIDP(s_str1),
-			IK_STRING_DATA_VOIDP(s_str2),
-			IK_UNFIX(s_len1) * IK_STRING_CHAR_SIZE));
-  } else
+  ikuword_t	len = IK_STRING_LENGTH(s_str1);
+  if (IK_STRING_LENGTH_FX(s_str1) != IK_STRING_LENGTH_FX(s_str2)) {
     return 0;
+  } else if (IK_STRING_IS_NARROW(s_str1) && IK_STRING_IS_NARROW(s_str2)) {
+    return (0 == memcmp(IK_STRING_DATA_UINT8P(s_str1), IK_STRING_DATA_UINT8P(s_str2), len));
+  } else if (IK_STRING_IS_NARROW(s_str1) || IK_STRING_IS_NARROW(s_str2)) {
+    ikuword_t	i;
+    for (i=0; i<len; ++i) {
+      if (ik_string_code_point(s_str1, i) != ik_string_code_point(s_str2, i)) {
+	return 0;
+      }
+    }
+    return 1;
+  } else {
+    return (0 == memcmp(IK_STRING_DATA_VOIDP(IK_STRING_WIDE_STRING(s_str1)),
+			IK_STRING_DATA_VOIDP(IK_STRING_WIDE_STRING(s_str2)),
+			len * IK_STRING_CHAR_SIZE));
+  }
 }
 
 
@@ -83,11 +95,14 @@ strings_eqp (ikptr_t s_str1, ikptr_t s_str2)
 
 static ikptr_t
 compute_string_hash (ikptr_t str, ikptr_t s_max_len)
-/* one-at-a-time from http://burtleburtle.net/bob/hash/doobs.html */
+/* one-at-a-time from http://burtleburtle.net/bob/hash/doobs.html
+
+   The hash value depends only on the code points, so that equal strings
+   have equal hash values whatever their representation. */
 {
-  ikptr_t	len  = IK_UNFIX(IK_REF(str, off_string_length));
-  ikchar_t *	data = IK_STRING_DATA_IKCHARP(str);
-  ikchar_t *	last;
+  ikptr_t	len  = IK_STRING_LENGTH(str);
+  ikptr_t	count;
+  ikptr_t	i;
   /* With this initialisation: two strings of different length will have
      different  hash value  even  when  they have  equal  chars used  to
      compute the hash value. */
@@ -103,14 +118,24 @@ compute_string_hash (ikptr_t str, ikptr_t s_max_len)
     } else {
       limit = IK_UNFIX(s_max_len);
     }
-    last  = data + ((len < limit)? len : limit);
+    count = (len < limit)? len : limit;
   }
   /* one-at-a-time */
-  for (; data < last; ++data) {
-    ikchar_t	c = IK_CHAR32_TO_INTEGER(*data);
-    H = H + c;
-    H = H + (H << 10);
-    H = H ^ (H >> 6);
+  if (IK_STRING_IS_NARROW(str)) {
+    uint8_t *	data = IK_STRING_DATA_UINT8P(str);
+    for (i=0; i<count; ++i) {
+      H = H + data[i];
+      H = H + (H << 10);
+      H = H ^ (H >> 6);
+    }
+  } else {
+    ikchar_t *	data = IK_STRING_DATA_IKCHARP(IK_STRING_WIDE_STRING(str));
+    for (i=0; i<count; ++i) {
+      ikchar_t	c = IK_CHAR32_TO_INTEGER(data[i]);
+      H = H + c;
+      H = H + (H << 10);
+      H = H ^ (H >> 6);
+    }
   }
   H = H + (H << 3);
   H = H ^ (H >> 11);
@@ -114,6 +114,9 @@ verify_page (uint8_t * mem,
   else if (type == WEAK_PAIRS_TYPE) {
     return verify_scheme_objects_page(mem, segment_bits, dirty_bits, mem_base, segment_vector, dirty_vector);
   }
+  else if (type == EPHEMERONS_TYPE) {
+    return verify_scheme_objects_page(mem, segment_bits, dirty_bits, mem_base, segment_vector, dirty_vector);
+  }
   else if (type == SYMBOLS_TYPE) {
     return verify_scheme_objects_page(mem, segment_bits, dirty_bits, mem_base, segment_vector, dirty_vector);
   }
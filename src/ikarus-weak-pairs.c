@@ -57,4 +57,39 @@ ikrt_is_weak_pair (ikptr_t x, ikpcb_t* pcb)
   }
 }
 
+/* ------------------------------------------------------------------ */
+
+ikptr_t
+ikrt_ephemeron_cons (ikptr_t a, ikptr_t d, ikpcb_t* pcb)
+/* Build and return a new ephemeron pair.   This is like "ikrt_weak_cons()",
+   but the pair is stored in an ephemerons page; the garbage collector keeps
+   the cdr alive only as long as the car is alive. */
+{
+  ikptr_t ap  = pcb->ephemerons_ap;
+  ikptr_t nap = ap + pair_size;
+  ikptr_t p;
+  if (nap > pcb->ephemerons_ep) {
+    ikptr_t mem = ik_mmap_typed(IK_PAGESIZE, EPHEMERONS_MT, pcb);
+    pcb->ephemerons_ap = mem + pair_size;
+    pcb->ephemerons_ep = mem + IK_PAGESIZE;
+    p = mem | pair_tag;
+  } else {
+    pcb->ephemerons_ap = nap;
+    p = ap | pair_tag;
+  }
+  IK_CAR(p) = a;
+  IK_CDR(p) = d;
+  return p;
+}
+ikptr_t
+ikrt_is_ephemeron_pair (ikptr_t x, ikpcb_t* pcb)
+{
+  if (IK_TAGOF(x) != pair_tag)
+    return IK_FALSE_OBJECT;
+  else {
+    uint32_t tag = pcb->segment_vector[IK_PAGE_INDEX(x)];
+    return IK_BOOLEAN_FROM_INT((tag & TYPE_MASK) == EPHEMERONS_TYPE);
+  }
+}
+
 /* end of file */
@@ -445,6 +445,7 @@
 #define CODE_TYPE		0x00000500
 #define WEAK_PAIRS_TYPE		0x00000600
 #define SYMBOLS_TYPE		0x00000700
+#define EPHEMERONS_TYPE		0x00000800
 
 /* Possible values for the bit field extracted by SCANNABLE_MASK. */
 #define SCANNABLE_TAG		0x00001000
@@ -470,6 +471,7 @@
 #define DATA_MT		(DATA_TYPE	 | UNSCANNABLE_TAG | DEALLOC_TAG_UN)
 #define CODE_MT		(CODE_TYPE	 | SCANNABLE_TAG   | DEALLOC_TAG_UN)
 #define WEAK_PAIRS_MT	(WEAK_PAIRS_TYPE | SCANNABLE_TAG   | DEALLOC_TAG_UN)
+#define EPHEMERONS_MT	(EPHEMERONS_TYPE | SCANNABLE_TAG   | DEALLOC_TAG_UN)
 
 
 /** --------------------------------------------------------------------
@@ -851,6 +853,19 @@ typedef struct ikpcb_t {
   ikptr_t		weak_pairs_ap;
   ikptr_t		weak_pairs_ep;
 
+  /* Ephemeron pairs storage.  An ephemeron pair has a "weak" reference
+   * to object in its car  and a reference to object in  its cdr that is
+   * strong only as long as the car is alive: the cdr does *not* keep the
+   * car alive, even  when it references it.  When the  car is collected:
+   * both the car and the cdr are set to the BWP object.
+   *
+   *   The memory storage for ephemeron pairs is in Vicare pages tagged in
+   * the segments vector as "ephemerons pages"; these fields are managed
+   * exactly like "weak_pairs_ap" and "weak_pairs_ep".
+   */
+  ikptr_t		ephemerons_ap;
+  ikptr_t		ephemerons_ep;
+
   /* The hash table holding interned symbols. */
   ikptr_t		symbol_table;
   /* The hash table holding interned generated symbols. */
@@ -862,6 +877,13 @@ typedef struct ikpcb_t {
      guardians. */
   ik_ptr_page_t *	protected_list[IK_GC_GENERATION_COUNT];
 
+  /* Array of linked lists; one for each GC generation.  The linked list
+     holds references to the widened strings in the generation; the data
+     pages holding  strings are never scanned  for dirty cards, so  it is
+     through  these lists  that the  garbage  collector finds  the wide
+     strings referenced by widened strings in older generations. */
+  ik_ptr_page_t *	widened_strings[IK_GC_GENERATION_COUNT];
+
   /* Number of garbage collections performed so far.  We shamelessly let
    * this integer overflow: it is fine.
    *
@@ -1046,6 +1068,8 @@ ik_decl ikptr_t	ik_unsafe_alloc		(ikpcb_t* pcb, ikuword_t size);
 ik_decl ikptr_t	ik_safe_alloc		(ikpcb_t* pcb, ikuword_t size);
 ik_decl void	ik_make_room_in_heap_nursery (ikpcb_t * pcb, ikuword_t aligned_size);
 
+ik_private_decl void ik_simd_init	(void);
+
 ik_decl void	ik_print		(ikptr_t x);
 ik_decl void	ik_print_no_newline	(ikptr_t x);
 ik_decl void	ik_fprint		(FILE*, ikptr_t x);
@@ -1242,19 +1266,58 @@ typedef ikchar_t	ikchar;
 #define off_string_length	(disp_string_length - string_tag)
 #define off_string_data		(disp_string_data   - string_tag)
 
+/* The first word of a string is a fixnum representing the number of
+   characters; its two least significant bits, which are zero in every
+   fixnum, select the representation of the data area:
+
+   IK_STRING_WIDE	one 32-bit character for every character;
+   IK_STRING_NARROW	one octet for every character, holding its code
+			point in the range [0, 255];
+   IK_STRING_WIDENED	a narrow string in which a character above #\xFF
+			has been stored: the first word of its data area
+			references a wide string holding all the characters.
+
+   A string never changes size, so a widened string keeps the size of the
+   narrow string it was; the size of a narrow string always leaves room
+   for one word in the data area. */
+#define IK_STRING_REPR_MASK	3
+#define IK_STRING_WIDE		0
+#define IK_STRING_NARROW	1
+#define IK_STRING_WIDENED	2
+
 #define IK_IS_STRING(X)			(string_tag == (string_mask & (ikptr_t)(X)))
-#define IK_STRING_LENGTH_FX(STR)	IK_REF((STR), off_string_length)
-#define IK_STRING_LENGTH(STR)		IK_UNFIX(IK_REF((STR), off_string_length))
-#define IK_CHAR32(STR,IDX)		(((ikchar_t*)(((ikptr_t)(STR)) + off_string_data))[IDX])
+#define IK_STRING_HEADER(STR)		IK_REF((STR), off_string_length)
+#define IK_STRING_REPR(STR)		(IK_STRING_REPR_MASK & IK_STRING_HEADER(STR))
+#define IK_STRING_IS_NARROW(STR)	(IK_STRING_NARROW == IK_STRING_REPR(STR))
+#define IK_STRING_LENGTH_FX(STR)	(IK_STRING_HEADER(STR) & ~((ikptr_t)IK_STRING_REPR_MASK))
+#define IK_STRING_LENGTH(STR)		IK_UNFIX(IK_STRING_LENGTH_FX(STR))
+
+#define IK_WIDE_STRING_SIZE(LEN)	IK_ALIGN(disp_string_data + (LEN) * IK_STRING_CHAR_SIZE)
+#define IK_NARROW_STRING_SIZE(LEN)	IK_ALIGN(disp_string_data + (LEN))
 
+/* The wide string holding the characters of the wide or widened string
+   STR. */
+#define IK_STRING_WIDE_STRING(STR)	\
+  ((IK_STRING_WIDENED == IK_STRING_REPR(STR))? IK_REF((STR), off_string_data) : (STR))
+
+/* Only for wide strings. */
+#define IK_CHAR32(STR,IDX)		(((ikchar_t*)(((ikptr_t)(STR)) + off_string_data))[IDX])
 #define IK_STRING_DATA_VOIDP(STR)	((void*)(((ikptr_t)(STR)) + off_string_data))
 #define IK_STRING_DATA_IKCHARP(STR)	((ikchar_t*)(((ikptr_t)(STR)) + off_string_data))
 
+/* Only for narrow strings. */
+#define IK_STRING_DATA_UINT8P(STR)	((uint8_t*)(((ikptr_t)(STR)) + off_string_data))
+
 ik_decl ikptr_t ika_string_alloc	(ikpcb_t * pcb, ikuword_t number_of_chars);
 ik_decl ikptr_t ika_string_from_cstring	(ikpcb_t * pcb, const char * cstr);
+ik_decl ikptr_t ika_narrow_string_alloc	(ikpcb_t * pcb, ikuword_t number_of_chars);
+ik_decl uint32_t ik_string_code_point	(ikptr_t s_str, ikuword_t idx);
+ik_decl void	ik_register_widened_string (ikpcb_t * pcb, ikptr_t s_str);
+ik_decl ikptr_t ikrt_string_widen	(ikptr_t s_str, ikpcb_t * pcb);
 
 ik_decl ikptr_t iku_string_alloc	(ikpcb_t * pcb, ikuword_t number_of_chars);
 ik_decl ikptr_t iku_string_from_cstring	(ikpcb_t * pcb, const char * cstr);
+ik_decl ikptr_t iku_narrow_string_alloc	(ikpcb_t * pcb, ikuword_t number_of_chars);
 ik_decl ikptr_t iku_string_to_symbol	(ikpcb_t * pcb, ikptr_t s_str);
 
 ik_decl ikptr_t ikrt_string_to_symbol	(ikptr_t, ikpcb_t* pcb);
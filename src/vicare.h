@@ -345,19 +345,53 @@ typedef uint32_t	ikchar;
 #define off_string_length	(disp_string_length - string_tag)
 #define off_string_data		(disp_string_data   - string_tag)
 
+/* The first word of a string is a fixnum representing the number of
+   characters; its two least significant bits, which are zero in every
+   fixnum, select the representation of the data area:
+
+   IK_STRING_WIDE	one 32-bit character for every character;
+   IK_STRING_NARROW	one octet for every character, holding its code
+			point in the range [0, 255];
+   IK_STRING_WIDENED	a narrow string in which a character above #\xFF
+			has been stored: the first word of its data area
+			references a wide string holding all the characters.
+
+   A string never changes size, so a widened string keeps the size of the
+   narrow string it was; the size of a narrow string always leaves room
+   for one word in the data area. */
+#define IK_STRING_REPR_MASK	3
+#define IK_STRING_WIDE		0
+#define IK_STRING_NARROW	1
+#define IK_STRING_WIDENED	2
+
 #define IK_IS_STRING(X)			(string_tag == (string_mask & (ikptr_t)(X)))
-#define IK_STRING_LENGTH_FX(STR)	IK_REF((STR), off_string_length)
-#define IK_STRING_LENGTH(STR)		IK_UNFIX(IK_REF((STR), off_string_length))
+#define IK_STRING_HEADER(STR)		IK_REF((STR), off_string_length)
+#define IK_STRING_REPR(STR)		(IK_STRING_REPR_MASK & IK_STRING_HEADER(STR))
+#define IK_STRING_IS_NARROW(STR)	(IK_STRING_NARROW == IK_STRING_REPR(STR))
+#define IK_STRING_LENGTH_FX(STR)	(IK_STRING_HEADER(STR) & ~((ikptr_t)IK_STRING_REPR_MASK))
+#define IK_STRING_LENGTH(STR)		IK_UNFIX(IK_STRING_LENGTH_FX(STR))
+
+/* The wide string holding the characters of the wide or widened string
+   STR. */
+#define IK_STRING_WIDE_STRING(STR)	\
+  ((IK_STRING_WIDENED == IK_STRING_REPR(STR))? IK_REF((STR), off_string_data) : (STR))
+
+/* Only for wide strings. */
 #define IK_CHAR32(STR,IDX)		(((ikchar*)(((ikptr_t)(STR)) + off_string_data))[IDX])
-
 #define IK_STRING_DATA_VOIDP(STR)	((void*)(((ikptr_t)(STR)) + off_string_data))
 #define IK_STRING_DATA_IKCHARP(STR)	((ikchar*)(((ikptr_t)(STR)) + off_string_data))
 
+/* Only for narrow strings. */
+#define IK_STRING_DATA_UINT8P(STR)	((uint8_t*)(((ikptr_t)(STR)) + off_string_data))
+
 ik_api_decl ikptr_t ika_string_alloc		(ikpcb_t * pcb, ikuword_t number_of_chars);
 ik_api_decl ikptr_t ika_string_from_cstring	(ikpcb_t * pcb, const char * cstr);
+ik_api_decl ikptr_t ika_narrow_string_alloc	(ikpcb_t * pcb, ikuword_t number_of_chars);
+ik_api_decl uint32_t ik_string_code_point	(ikptr_t s_str, ikuword_t idx);
 
 ik_api_decl ikptr_t iku_string_alloc		(ikpcb_t * pcb, ikuword_t number_of_chars);
 ik_api_decl ikptr_t iku_string_from_cstring	(ikpcb_t * pcb, const char * cstr);
+ik_api_decl ikptr_t iku_narrow_string_alloc	(ikpcb_t * pcb, ikuword_t number_of_chars);
 ik_api_decl ikptr_t iku_string_to_symbol		(ikpcb_t * pcb, ikptr_t s_str);
 
 ik_api_decl ikptr_t ikrt_string_to_symbol	(ikptr_t, ikpcb_t* pcb);